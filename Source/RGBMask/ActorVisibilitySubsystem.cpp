@@ -0,0 +1,128 @@
+#include "ActorVisibilitySubsystem.h"
+#include "GameFramework/Actor.h"
+
+bool UActorVisibilitySubsystem::FActorHideState::HasAnyRequest() const
+{
+    for (const uint16 Count : Counts)
+    {
+        if (Count > 0) return true;
+    }
+    return false;
+}
+
+void UActorVisibilitySubsystem::AddHideRequest(AActor* Actor, EActorHideReason Reason)
+{
+    if (!IsValid(Actor) || Reason >= EActorHideReason::Count) return;
+
+    const TObjectKey<AActor> Key(Actor);
+    FActorHideState* State = States.Find(Key);
+    if (!State)
+    {
+        State = &States.Add(Key);
+        State->Actor = Actor;
+        State->bBaseHidden = Actor->IsHidden();
+    }
+
+    ++State->Counts[static_cast<uint8>(Reason)];
+    MarkDirty(Key, *State);
+}
+
+void UActorVisibilitySubsystem::RemoveHideRequest(AActor* Actor, EActorHideReason Reason)
+{
+    if (!Actor || Reason >= EActorHideReason::Count) return;
+
+    const TObjectKey<AActor> Key(Actor);
+    FActorHideState* State = States.Find(Key);
+    if (!State) return;
+
+    uint16& Count = State->Counts[static_cast<uint8>(Reason)];
+    if (Count == 0) return;
+
+    --Count;
+    MarkDirty(Key, *State);
+}
+
+bool UActorVisibilitySubsystem::IsHideRequested(const AActor* Actor) const
+{
+    const FActorHideState* State = States.Find(TObjectKey<AActor>(Actor));
+    return State && State->HasAnyRequest();
+}
+
+void UActorVisibilitySubsystem::ClearAuthoredHidden(AActor* Actor)
+{
+    if (!IsValid(Actor)) return;
+
+    const TObjectKey<AActor> Key(Actor);
+    FActorHideState* State = States.Find(Key);
+    if (!State)
+    {
+        // Untracked and visible: nothing to clear
+        if (!Actor->IsHidden()) return;
+
+        State = &States.Add(Key);
+        State->Actor = Actor;
+    }
+    else if (!State->bBaseHidden)
+    {
+        return;
+    }
+
+    State->bBaseHidden = false;
+    MarkDirty(Key, *State);
+}
+
+void UActorVisibilitySubsystem::MarkDirty(const TObjectKey<AActor>& Key, FActorHideState& State)
+{
+    if (State.bDirty) return;
+
+    State.bDirty = true;
+    DirtyActors.Add(Key);
+}
+
+void UActorVisibilitySubsystem::Flush()
+{
+    for (const TObjectKey<AActor>& Key : DirtyActors)
+    {
+        FActorHideState* State = States.Find(Key);
+        if (!State) continue;
+
+        AActor* Actor = State->Actor.Get();
+        if (!Actor)
+        {
+            States.Remove(Key);
+            continue;
+        }
+
+        State->bDirty = false;
+
+        // Only touch the actor when the resolved state actually differs
+        const bool bHidden = State->ShouldBeHidden();
+        if (Actor->IsHidden() != bHidden)
+        {
+            Actor->SetActorHiddenInGame(bHidden);
+        }
+
+        // Nobody holds a request anymore: the actor is back to its authored state, stop tracking it
+        if (!State->HasAnyRequest())
+        {
+            States.Remove(Key);
+        }
+    }
+
+    DirtyActors.Reset();
+}
+
+void UActorVisibilitySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (DirtyActors.Num() > 0)
+    {
+        Flush();
+    }
+}
+
+TStatId UActorVisibilitySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UActorVisibilitySubsystem, STATGROUP_Tickables);
+}
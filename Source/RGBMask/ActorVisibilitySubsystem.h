@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ActorVisibilitySubsystem.generated.h"
+
+/** Who is asking for an actor to be hidden. Each reason is reference counted independently. */
+UENUM(BlueprintType)
+enum class EActorHideReason : uint8
+{
+    CameraVolume UMETA(DisplayName = "Camera Volume"),
+    Mask         UMETA(DisplayName = "Mask"),
+    Gameplay     UMETA(DisplayName = "Gameplay"),
+
+    Count        UMETA(Hidden)
+};
+
+/**
+ * Single writer for actor hidden-in-game state.
+ * Camera volumes, mask components and gameplay code add/remove hide requests here instead of
+ * calling SetActorHiddenInGame themselves; requests only mark the actor dirty and the final
+ * visibility is resolved once per frame in one batch, so conflicting writers can't flicker it.
+ */
+UCLASS()
+class RGBMASK_API UActorVisibilitySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Visibility")
+    void AddHideRequest(AActor* Actor, EActorHideReason Reason);
+
+    UFUNCTION(BlueprintCallable, Category = "Visibility")
+    void RemoveHideRequest(AActor* Actor, EActorHideReason Reason);
+
+    /** True if any reason currently holds a hide request for the actor (pending or applied) */
+    UFUNCTION(BlueprintPure, Category = "Visibility")
+    bool IsHideRequested(const AActor* Actor) const;
+
+    /**
+     * Drop the authored hidden state so the actor is only hidden while someone holds a request.
+     * Used by mask components, which are allowed to reveal actors placed hidden in the level.
+     */
+    void ClearAuthoredHidden(AActor* Actor);
+
+    /** Resolve all dirty actors now instead of waiting for the end-of-frame pass */
+    void Flush();
+
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickableWhenPaused() const override { return true; }
+    virtual TStatId GetStatId() const override;
+
+private:
+    struct FActorHideState
+    {
+        TWeakObjectPtr<AActor> Actor;
+        uint16 Counts[static_cast<uint8>(EActorHideReason::Count)] = {};
+
+        // Hidden state the actor had before anyone requested a hide (authored state)
+        bool bBaseHidden = false;
+        bool bDirty = false;
+
+        bool HasAnyRequest() const;
+        bool ShouldBeHidden() const { return bBaseHidden || HasAnyRequest(); }
+    };
+
+    void MarkDirty(const TObjectKey<AActor>& Key, FActorHideState& State);
+
+    TMap<TObjectKey<AActor>, FActorHideState> States;
+    TArray<TObjectKey<AActor>> DirtyActors;
+};
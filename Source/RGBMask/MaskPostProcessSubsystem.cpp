@@ -0,0 +1,79 @@
+#include "MaskPostProcessSubsystem.h"
+#include "Engine/PostProcessVolume.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "RGBMask.h"
+
+const FName UMaskPostProcessSubsystem::MaskVolumeTag(TEXT("MaskPostProcess"));
+
+bool UMaskPostProcessSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+APostProcessVolume* UMaskPostProcessSubsystem::GetMaskPostProcessVolume()
+{
+    // Si el volumen cacheado se destruyó (p.ej. descarga de subnivel) se vuelve a buscar
+    if (!bResolved || (!CachedVolume.IsValid() && !CachedVolume.IsExplicitlyNull()))
+    {
+        ResolveVolume();
+    }
+    return CachedVolume.Get();
+}
+
+void UMaskPostProcessSubsystem::SetMaskPostProcessVolume(APostProcessVolume* Volume)
+{
+    CachedVolume = Volume;
+    bResolved = true;
+}
+
+void UMaskPostProcessSubsystem::ResolveVolume()
+{
+    bResolved = true;
+    CachedVolume.Reset();
+
+    UWorld* World = GetWorld();
+    if (!World) return;
+
+    APostProcessVolume* FirstUnbound = nullptr;
+    APostProcessVolume* FirstAny = nullptr;
+    int32 NumFound = 0;
+
+    for (TActorIterator<APostProcessVolume> It(World); It; ++It)
+    {
+        APostProcessVolume* PPV = *It;
+        ++NumFound;
+
+        if (PPV->ActorHasTag(MaskVolumeTag))
+        {
+            CachedVolume = PPV;
+            UE_LOG(LogRGBMaskPostProcess, Log, TEXT("Mask PostProcessVolume: %s (tagged %s)"), *PPV->GetName(), *MaskVolumeTag.ToString());
+            return;
+        }
+
+        if (!FirstUnbound && PPV->bUnbound)
+        {
+            FirstUnbound = PPV;
+        }
+        if (!FirstAny)
+        {
+            FirstAny = PPV;
+        }
+    }
+
+    if (FirstUnbound)
+    {
+        CachedVolume = FirstUnbound;
+        UE_LOG(LogRGBMaskPostProcess, Log, TEXT("Mask PostProcessVolume: %s (unbound, %d volumes in level)"), *FirstUnbound->GetName(), NumFound);
+    }
+    else if (FirstAny)
+    {
+        CachedVolume = FirstAny;
+        UE_LOG(LogRGBMaskPostProcess, Warning, TEXT("Using first PostProcessVolume (NOT unbound): %s. Consider setting bUnbound=true or tagging it %s"),
+            *FirstAny->GetName(), *MaskVolumeTag.ToString());
+    }
+    else
+    {
+        UE_LOG(LogRGBMaskPostProcess, Error, TEXT("No PostProcessVolume found in level! Mask post-process effects will not work."));
+    }
+}
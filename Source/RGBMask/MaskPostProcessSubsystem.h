@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MaskPostProcessSubsystem.generated.h"
+
+class APostProcessVolume;
+
+/**
+ * Resolves, once per world, the post-process volume the mask effects are written to.
+ * Preference order: a volume tagged MaskVolumeTag, then the first unbound volume, then any volume.
+ * Characters query it on BeginPlay instead of scanning the level on every spawn.
+ */
+UCLASS()
+class UMaskPostProcessSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Actor tag that marks the designated mask post-process volume */
+    static const FName MaskVolumeTag;
+
+    /** Cached volume (resolved on first use, re-resolved only if it was destroyed) */
+    UFUNCTION(BlueprintCallable, Category = "Mask|PostProcess")
+    APostProcessVolume* GetMaskPostProcessVolume();
+
+    /** Override the auto-detected volume (e.g. a level script choosing a specific one) */
+    UFUNCTION(BlueprintCallable, Category = "Mask|PostProcess")
+    void SetMaskPostProcessVolume(APostProcessVolume* Volume);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    TWeakObjectPtr<APostProcessVolume> CachedVolume;
+
+    // Evita repetir la búsqueda en niveles que no tienen ningún volumen
+    bool bResolved = false;
+
+    void ResolveVolume();
+};
@@ -0,0 +1,152 @@
+#include "MaskSwitchStats.h"
+#include "HAL/IConsoleManager.h"
+#include "RGBMask.h"
+
+DEFINE_STAT(STAT_MaskSwitch_Toggle);
+DEFINE_STAT(STAT_MaskSwitch_SetMask);
+DEFINE_STAT(STAT_MaskSwitch_ApplyMaskChange);
+DEFINE_STAT(STAT_MaskSwitch_Broadcast);
+DEFINE_STAT(STAT_MaskSwitch_ApplyMaskToAll);
+DEFINE_STAT(STAT_MaskSwitch_PostProcess);
+DEFINE_STAT(STAT_MaskSwitch_ActorsTouched);
+
+#if RGBMASK_MASK_SWITCH_TIMING
+namespace MaskSwitchStats
+{
+    struct FSwitchTiming
+    {
+        EMaskType Mask = EMaskType::None;
+        double InputTime = 0.0;
+        double InputToAppliedMs = 0.0;
+        double StageMs[static_cast<int32>(EMaskSwitchStage::Count)] = {};
+        int32 ActorsTouched = 0;
+    };
+
+    // Solo game thread: el cambio de máscara nunca sale de él
+    static constexpr int32 HistorySize = 32;
+    static FSwitchTiming History[HistorySize];
+    static int32 HistoryCount = 0;
+    static int32 HistoryNext = 0;
+
+    static FSwitchTiming Current;
+    static bool bSwitchOpen = false;
+    static bool bSwitchApplied = false;
+    static bool bPostProcessPending = false;
+
+    // Stage scopes currently on the stack: the record isn't pushed while one of them can still add to it
+    static int32 ScopeDepth = 0;
+
+    static const TCHAR* StageNames[] = { TEXT("Toggle"), TEXT("SetMask"), TEXT("ApplyMaskChange"), TEXT("Broadcast"), TEXT("ApplyMaskToAll"), TEXT("PostProcess") };
+    static_assert(UE_ARRAY_COUNT(StageNames) == static_cast<int32>(EMaskSwitchStage::Count), "StageNames out of sync with EMaskSwitchStage");
+
+    static void PushSwitch()
+    {
+        History[HistoryNext] = Current;
+        HistoryNext = (HistoryNext + 1) % HistorySize;
+        HistoryCount = FMath::Min(HistoryCount + 1, HistorySize);
+        AbortSwitch();
+    }
+
+    static void TryPushSwitch()
+    {
+        if (bSwitchOpen && bSwitchApplied && !bPostProcessPending && ScopeDepth == 0)
+        {
+            PushSwitch();
+        }
+    }
+
+    void BeginSwitch(EMaskType Mask, double InputTime)
+    {
+        // An applied switch whose blend is cut short by this one is still a complete switch
+        if (bSwitchOpen && bSwitchApplied)
+        {
+            PushSwitch();
+        }
+
+        Current = FSwitchTiming();
+        Current.Mask = Mask;
+        Current.InputTime = InputTime > 0.0 ? InputTime : FPlatformTime::Seconds();
+        bSwitchOpen = true;
+    }
+
+    void MarkApplied()
+    {
+        if (!bSwitchOpen || bSwitchApplied) return;
+
+        Current.InputToAppliedMs = (FPlatformTime::Seconds() - Current.InputTime) * 1000.0;
+        bSwitchApplied = true;
+        TryPushSwitch();
+    }
+
+    void SetPostProcessPending(bool bPending)
+    {
+        bPostProcessPending = bSwitchOpen && bPending;
+        TryPushSwitch();
+    }
+
+    void AbortSwitch()
+    {
+        bSwitchOpen = false;
+        bSwitchApplied = false;
+        bPostProcessPending = false;
+    }
+
+    void AddActorsTouched(int32 Count)
+    {
+        if (bSwitchOpen)
+        {
+            Current.ActorsTouched += Count;
+        }
+    }
+
+    FStageScope::FStageScope(EMaskSwitchStage InStage)
+        : Stage(InStage)
+        , StartCycles(FPlatformTime::Cycles64())
+    {
+        ++ScopeDepth;
+    }
+
+    FStageScope::~FStageScope()
+    {
+        --ScopeDepth;
+
+        if (bSwitchOpen)
+        {
+            Current.StageMs[static_cast<int32>(Stage)] += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+            TryPushSwitch();
+        }
+    }
+
+    static void PrintTimings(const TArray<FString>& Args)
+    {
+        const int32 Requested = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10;
+        const int32 Num = FMath::Clamp(Requested, 1, HistoryCount);
+
+        if (HistoryCount == 0)
+        {
+            UE_LOG(LogRGBMaskMasks, Display, TEXT("No mask switches recorded yet"));
+            return;
+        }
+
+        UE_LOG(LogRGBMaskMasks, Display, TEXT("Last %d mask switches (newest first), times in ms:"), Num);
+        for (int32 i = 0; i < Num; ++i)
+        {
+            const FSwitchTiming& Timing = History[(HistoryNext - 1 - i + HistorySize) % HistorySize];
+
+            FString Stages;
+            for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EMaskSwitchStage::Count); ++StageIndex)
+            {
+                Stages += FString::Printf(TEXT(" %s=%.3f"), StageNames[StageIndex], Timing.StageMs[StageIndex]);
+            }
+
+            UE_LOG(LogRGBMaskMasks, Display, TEXT("  [%d] mask=%d input->applied=%.2f actors=%d |%s"),
+                i, static_cast<int32>(Timing.Mask), Timing.InputToAppliedMs, Timing.ActorsTouched, *Stages);
+        }
+    }
+
+    static FAutoConsoleCommand CmdMaskSwitchTimings(
+        TEXT("rgbmask.MaskSwitchTimings"),
+        TEXT("Prints the stage timings of the last N mask switches (default 10, max 32). input->applied includes MaskChangeDelay."),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&PrintTimings));
+}
+#endif
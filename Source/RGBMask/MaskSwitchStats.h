@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "MaskTypes.h"
+
+/**
+ * Instrumentation for the mask switch path:
+ * ToggleMask -> SetMask -> (MaskChangeDelay) -> ApplyMaskChange -> OnMaskChanged -> ApplyMaskToAll / post-process.
+ *
+ * Every stage gets a cycle stat ("stat MaskSwitch") and an Insights CPU scope. Outside Shipping the
+ * stage times of the last switches are also kept in a ring buffer; rgbmask.MaskSwitchTimings [N] prints them.
+ * Stage times are inclusive: Broadcast contains ApplyMaskToAll, SetMask contains ApplyMaskChange when MaskChangeDelay is 0.
+ * A record is pushed once the switch has been applied, the outermost stage scope has exited and the smooth post-process
+ * blend (if any) has finished, so every stage of the switch, including a delay of 0 and the PostProcess ticks, is in it.
+ */
+
+DECLARE_STATS_GROUP(TEXT("MaskSwitch"), STATGROUP_MaskSwitch, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ToggleMask (input)"), STAT_MaskSwitch_Toggle, STATGROUP_MaskSwitch, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SetMask"), STAT_MaskSwitch_SetMask, STATGROUP_MaskSwitch, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyMaskChange"), STAT_MaskSwitch_ApplyMaskChange, STATGROUP_MaskSwitch, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnMaskChanged broadcast"), STAT_MaskSwitch_Broadcast, STATGROUP_MaskSwitch, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyMaskToAll"), STAT_MaskSwitch_ApplyMaskToAll, STATGROUP_MaskSwitch, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PostProcess update"), STAT_MaskSwitch_PostProcess, STATGROUP_MaskSwitch, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors touched"), STAT_MaskSwitch_ActorsTouched, STATGROUP_MaskSwitch, );
+
+#define RGBMASK_MASK_SWITCH_TIMING !UE_BUILD_SHIPPING
+
+enum class EMaskSwitchStage : uint8
+{
+    Toggle,
+    SetMask,
+    ApplyMaskChange,
+    Broadcast,
+    ApplyMaskToAll,
+    PostProcess,
+
+    Count
+};
+
+namespace MaskSwitchStats
+{
+#if RGBMASK_MASK_SWITCH_TIMING
+    /**
+     * Opens a timing record for a switch that will actually happen. InputTime is the FPlatformTime::Seconds()
+     * of the input that caused it (0 = now). A record still open is discarded: its switch was superseded
+     */
+    void BeginSwitch(EMaskType Mask, double InputTime = 0.0);
+
+    /**
+     * The switch reached ApplyMaskChange: stamps input->applied. The record is pushed to the history when the
+     * outermost stage scope exits and no post-process blend holds it
+     */
+    void MarkApplied();
+
+    /** A smooth post-process blend is running for the open record: keep it open until the blend ends */
+    void SetPostProcessPending(bool bPending);
+
+    /** Discards the open record without adding it to the history (cancelled switch, owner gone) */
+    void AbortSwitch();
+
+    void AddActorsTouched(int32 Count);
+
+    /** Accumulates the scope's duration into the open record's stage */
+    struct FStageScope
+    {
+        explicit FStageScope(EMaskSwitchStage InStage);
+        ~FStageScope();
+
+    private:
+        EMaskSwitchStage Stage;
+        uint64 StartCycles;
+    };
+#else
+    FORCEINLINE void BeginSwitch(EMaskType, double = 0.0) {}
+    FORCEINLINE void MarkApplied() {}
+    FORCEINLINE void SetPostProcessPending(bool) {}
+    FORCEINLINE void AbortSwitch() {}
+    FORCEINLINE void AddActorsTouched(int32) {}
+
+    struct FStageScope
+    {
+        explicit FStageScope(EMaskSwitchStage) {}
+    };
+#endif
+}
+
+/** Cycle stat + Insights scope + history timing for one stage of the mask switch */
+#define RGBMASK_MASK_SWITCH_SCOPE(Stage) \
+    SCOPE_CYCLE_COUNTER(STAT_MaskSwitch_##Stage); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(MaskSwitch_##Stage); \
+    MaskSwitchStats::FStageScope PREPROCESSOR_JOIN(MaskSwitchStageScope, __LINE__)(EMaskSwitchStage::Stage)
@@ -10,5 +10,12 @@ enum class EMaskType : uint8
     Red   UMETA(DisplayName = "Red"),
     Green UMETA(DisplayName = "Green"),
     Blue  UMETA(DisplayName = "Blue"),
-    None  UMETA(DisplayName = "None")
+    None  UMETA(DisplayName = "None"),
+
+    Count UMETA(Hidden)
 };
+
+/** Size of the per-mask lookup tables (inventory bits, materials, blendables) */
+constexpr int32 NumMaskTypes = static_cast<int32>(EMaskType::Count);
+
+FORCEINLINE int32 GetMaskIndex(EMaskType Mask) { return static_cast<int32>(Mask); }
@@ -2,6 +2,7 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "MaskVisibilitySubsystem.h"
+#include "ActorVisibilitySubsystem.h"
 #include "Engine/World.h"
 
 
@@ -54,6 +55,8 @@ void UMaskVisibilityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
             Sub->Unregister(this);
         }
     }
+    SetHideRequest(false);
+
     if (ActiveHideFXComponent)
     {
         ActiveHideFXComponent->DeactivateImmediate();
@@ -85,6 +88,25 @@ void UMaskVisibilityComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 
 
 
+void UMaskVisibilityComponent::SetHideRequest(bool bHide)
+{
+    if (bHoldsHideRequest == bHide) return;
+
+    UWorld* World = GetWorld();
+    UActorVisibilitySubsystem* Visibility = World ? World->GetSubsystem<UActorVisibilitySubsystem>() : nullptr;
+    if (!Visibility) return;
+
+    if (bHide)
+    {
+        Visibility->AddHideRequest(GetOwner(), EActorHideReason::Mask);
+    }
+    else
+    {
+        Visibility->RemoveHideRequest(GetOwner(), EActorHideReason::Mask);
+    }
+    bHoldsHideRequest = bHide;
+}
+
 void UMaskVisibilityComponent::ApplyMask(EMaskType Mask, bool bAllowFX)
 {
     bool bShouldBeHidden = false;
@@ -209,8 +231,18 @@ void UMaskVisibilityComponent::ApplyMask(EMaskType Mask, bool bAllowFX)
         SetComponentTickEnabled(false); // no follow en modo transicin
     }
 
-    // --- Visibilidad core (no lo tocamos) ---
-    Owner->SetActorHiddenInGame(bShouldBeHidden);
+    // --- Visibilidad core ---
+    // No escribimos directamente: el subsistema combina mscara, volmenes de cmara y gameplay
+    SetHideRequest(bShouldBeHidden);
+
+    // Como antes de centralizar la visibilidad: la mscara puede mostrar actores colocados ocultos
+    if (!bShouldBeHidden)
+    {
+        if (UActorVisibilitySubsystem* Visibility = GetWorld() ? GetWorld()->GetSubsystem<UActorVisibilitySubsystem>() : nullptr)
+        {
+            Visibility->ClearAuthoredHidden(Owner);
+        }
+    }
 
     if (bDisableCollisionWhenHidden)
         Owner->SetActorEnableCollision(!bShouldBeHidden);
@@ -132,6 +132,11 @@ private:
 
     bool bWasHidden = false;
 
+    // True mientras este componente tiene una peticin Mask activa en UActorVisibilitySubsystem
+    bool bHoldsHideRequest = false;
+
+    void SetHideRequest(bool bHide);
+
     UPROPERTY(EditDefaultsOnly, Category = "Mask|FX")
     FLinearColor RedFXColor = FLinearColor(1.0f, 0.35f, 0.35f, 1.0f);   // rojo ms vivo
 
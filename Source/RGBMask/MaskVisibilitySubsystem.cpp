@@ -6,6 +6,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
+#include "MaskSwitchStats.h"
 
 void UMaskVisibilitySubsystem::Register(UMaskVisibilityComponent* Comp)
 {
@@ -68,15 +69,22 @@ void UMaskVisibilitySubsystem::PruneInvalid()
 
 void UMaskVisibilitySubsystem::ApplyMaskToAll(bool bAllowFX)
 {
+    RGBMASK_MASK_SWITCH_SCOPE(ApplyMaskToAll);
+
     PruneInvalid();
 
+    int32 NumTouched = 0;
     for (const TWeakObjectPtr<UMaskVisibilityComponent>& WeakComp : Registered)
     {
         if (UMaskVisibilityComponent* Comp = WeakComp.Get())
         {
             Comp->ApplyMask(CurrentMask, bAllowFX);
+            ++NumTouched;
         }
     }
+
+    INC_DWORD_STAT_BY(STAT_MaskSwitch_ActorsTouched, NumTouched);
+    MaskSwitchStats::AddActorsTouched(NumTouched);
 }
 
 void UMaskVisibilitySubsystem::ScheduleBindRetry()
@@ -2,13 +2,19 @@
 
 
 #include "Camera/CameraVolume.h"
+#include "Camera/CameraVolumeSubsystem.h"
+#include "ActorVisibilitySubsystem.h"
+#include "RGBMask.h"
 #include "Components/BrushComponent.h"
+#include "Engine/World.h"
+#include "Engine/LevelStreaming.h"
+#include "Kismet/GameplayStatics.h"
 
 // Sets default values
 ACameraVolume::ACameraVolume()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// No necesita tick: los lmites se recalculan solo cuando cambia el transform
+	PrimaryActorTick.bCanEverTick = false;
     
     if (GetBrushComponent())
     {
@@ -23,6 +29,14 @@ ACameraVolume::ACameraVolume()
 
 void ACameraVolume::GetVolumeBounds(FVector& OutMin, FVector& OutMax) const
 {
+    if (CachedBounds.IsValid)
+    {
+        OutMin = CachedBounds.Min;
+        OutMax = CachedBounds.Max;
+        return;
+    }
+
+    // An no cacheado (consulta antes de BeginPlay)
     FVector Origin, BoxExtent;
     GetActorBounds(false, Origin, BoxExtent);
 
@@ -32,6 +46,16 @@ void ACameraVolume::GetVolumeBounds(FVector& OutMin, FVector& OutMax) const
 
 bool ACameraVolume::IsLocationInsideVolume(const FVector& Location) const
 {
+    if (bUseOrientedBounds && LocalBounds.IsValid)
+    {
+        return LocalBounds.IsInside(WorldToLocal.TransformPosition(Location));
+    }
+
+    if (CachedBounds.IsValid)
+    {
+        return CachedBounds.IsInside(Location);
+    }
+
     FVector MinBounds, MaxBounds;
     GetVolumeBounds(MinBounds, MaxBounds);
 
@@ -40,8 +64,37 @@ bool ACameraVolume::IsLocationInsideVolume(const FVector& Location) const
     return VolumeBox.IsInside(Location);
 }
 
+void ACameraVolume::RefreshCachedBounds()
+{
+    FVector Origin, BoxExtent;
+    GetActorBounds(false, Origin, BoxExtent);
+
+    CachedBounds = FBox(Origin - BoxExtent, Origin + BoxExtent);
+    CachedCameraBounds = FBox(CachedBounds.Min - CameraMargin, CachedBounds.Max + CameraMargin);
+
+    // El brush es el root, as que su espacio de componente es el espacio local del actor
+    if (const UBrushComponent* Brush = GetBrushComponent())
+    {
+        LocalBounds = Brush->CalcBounds(FTransform::Identity).GetBox();
+        WorldToLocal = GetActorTransform().ToInverseMatrixWithScale();
+    }
+}
+
+void ACameraVolume::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    RefreshCachedBounds();
+    OnBoundsChanged.Broadcast(this);
+}
+
 void ACameraVolume::GetCameraBounds(FVector& OutMin, FVector& OutMax) const
 {
+    if (CachedCameraBounds.IsValid)
+    {
+        OutMin = CachedCameraBounds.Min;
+        OutMax = CachedCameraBounds.Max;
+        return;
+    }
+
     // Obtener los lmites base del volumen
     GetVolumeBounds(OutMin, OutMax);
 
@@ -54,87 +107,192 @@ void ACameraVolume::GetCameraBounds(FVector& OutMin, FVector& OutMax) const
 void ACameraVolume::BeginPlay()
 {
 	Super::BeginPlay();
+
+    RefreshCachedBounds();
+
+    if (USceneComponent* Root = GetRootComponent())
+    {
+        Root->TransformUpdated.AddUObject(this, &ACameraVolume::OnRootTransformUpdated);
+    }
+
+    // Auto-registro: el camera manager consulta el subsistema, as que los volmenes
+    // de subniveles cargados por streaming aparecen (y desaparecen) solos
+    if (UWorld* World = GetWorld())
+    {
+        if (UCameraVolumeSubsystem* Sub = World->GetSubsystem<UCameraVolumeSubsystem>())
+        {
+            Sub->Register(this);
+        }
+    }
 	
-    UE_LOG(LogTemp, Warning, TEXT("[CameraVolume] BeginPlay - Volume: %s, HiddenActors count: %d"), *GetName(), HiddenActors.Num());
+    UE_LOG(LogRGBMaskCamera, Verbose, TEXT("[CameraVolume] BeginPlay - Volume: %s, HiddenActors count: %d"), *GetName(), HiddenActors.Num());
+
+    for (AActor* Actor : HiddenActors)
+    {
+        if (!IsValid(Actor))
+        {
+            UE_LOG(LogRGBMaskCamera, Error, TEXT("[CameraVolume] Invalid actor in HiddenActors list at BeginPlay!"));
+        }
+    }
+}
+
+void ACameraVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Si el volumen se descarga estando activo, no dejar actores ocultos para siempre
+    ShowActors();
+    CancelTransition();
+
+    if (UWorld* World = GetWorld())
+    {
+        if (UCameraVolumeSubsystem* Sub = World->GetSubsystem<UCameraVolumeSubsystem>())
+        {
+            Sub->Unregister(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ACameraVolume::PrepareTransition()
+{
+    if (bTransitionPrepared)
+        return;
+
+    if (!CachedBounds.IsValid)
+    {
+        RefreshCachedBounds();
+    }
 
+    PreparedHiddenActors.Reset();
+    PreparedHiddenActors.Reserve(HiddenActors.Num());
     for (AActor* Actor : HiddenActors)
     {
         if (IsValid(Actor))
         {
-            OriginalVisibilityState.Add(Actor, Actor->IsHidden());
-            UE_LOG(LogTemp, Log, TEXT("[CameraVolume] Registered actor: %s (originally hidden: %s)"),
-                *Actor->GetName(),
-                Actor->IsHidden() ? TEXT("YES") : TEXT("NO"));
+            PreparedHiddenActors.Add(Actor);
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("[CameraVolume] Invalid actor in HiddenActors list at BeginPlay!"));
+            UE_LOG(LogRGBMaskCamera, Error, TEXT("[CameraVolume] Invalid actor in HiddenActors list!"));
         }
     }
 
-    
+    // Solo carga asncrona: la prediccin puede fallar, as que no se hace visible nada todava.
+    // Con refcount en el subsistema: otro volumen con el mismo subnivel no lo descarga al soltarlo
+    UCameraVolumeSubsystem* VolumeSub = GetWorld() ? GetWorld()->GetSubsystem<UCameraVolumeSubsystem>() : nullptr;
+    for (const TSoftObjectPtr<UWorld>& Level : PrefetchLevels)
+    {
+        if (Level.IsNull() || !VolumeSub)
+            continue;
+
+        const FName PackageName(*FPackageName::ObjectPathToPackageName(Level.ToString()));
+        if (ULevelStreaming* Streaming = UGameplayStatics::GetStreamingLevel(this, PackageName))
+        {
+            VolumeSub->RequestLevelStreaming(Streaming, false);
+            PrefetchedStreamingLevels.Add(Streaming);
+        }
+    }
+
+    bTransitionPrepared = true;
 }
 
-// Called every frame
-void ACameraVolume::Tick(float DeltaTime)
+void ACameraVolume::CancelTransition()
 {
-	Super::Tick(DeltaTime);
+    if (!bTransitionPrepared)
+        return;
 
+    UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraVolume] CancelTransition on %s, releasing %d levels"), *GetName(), PrefetchedStreamingLevels.Num());
+
+    if (UCameraVolumeSubsystem* VolumeSub = GetWorld() ? GetWorld()->GetSubsystem<UCameraVolumeSubsystem>() : nullptr)
+    {
+        for (const TWeakObjectPtr<ULevelStreaming>& WeakStreaming : PrefetchedStreamingLevels)
+        {
+            VolumeSub->ReleaseLevelStreaming(WeakStreaming.Get(), false);
+        }
+    }
+
+    PrefetchedStreamingLevels.Reset();
+    PreparedHiddenActors.Reset();
+    bTransitionPrepared = false;
 }
 
 void ACameraVolume::HideActors()
 {
-    UE_LOG(LogTemp, Warning, TEXT("[CameraVolume] HideActors called on %s, HiddenActors count: %d"), *GetName(), HiddenActors.Num());
+    UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraVolume] HideActors called on %s, HiddenActors count: %d"), *GetName(), HiddenActors.Num());
 
-    for (AActor* Actor : HiddenActors)
+    // Ya tenemos las peticiones hechas: no duplicar el refcount
+    if (bIsActive)
+        return;
+
+    bIsActive = true;
+
+    // Normalmente ya lo hizo el manager unos frames antes (prediccin); si no, se hace ahora
+    PrepareTransition();
+
+    // Ya no es una prediccin: los niveles precargados pasan a visibles hasta que salgamos del volumen.
+    // Se pide visible antes de soltar la carga para que el refcount no llegue a 0 entre medias
+    if (UCameraVolumeSubsystem* VolumeSub = GetWorld() ? GetWorld()->GetSubsystem<UCameraVolumeSubsystem>() : nullptr)
     {
-        if (IsValid(Actor))
+        for (const TWeakObjectPtr<ULevelStreaming>& WeakStreaming : PrefetchedStreamingLevels)
         {
-            // Guardar el estado original de visibilidad si no lo hemos guardado antes
-            if (!OriginalVisibilityState.Contains(Actor))
+            if (ULevelStreaming* Streaming = WeakStreaming.Get())
             {
-                OriginalVisibilityState.Add(Actor, Actor->IsHidden());
+                VolumeSub->RequestLevelStreaming(Streaming, true);
+                VolumeSub->ReleaseLevelStreaming(Streaming, false);
+                ActiveStreamingLevels.Add(Streaming);
             }
+        }
+    }
 
-            UE_LOG(LogTemp, Warning, TEXT("[CameraVolume] Hiding actor: %s (was hidden: %s)"),
-                *Actor->GetName(),
-                Actor->IsHidden() ? TEXT("YES") : TEXT("NO"));
-
-            // Ocultar el actor
-            Actor->SetActorHiddenInGame(true);
+    if (UActorVisibilitySubsystem* Visibility = GetWorld() ? GetWorld()->GetSubsystem<UActorVisibilitySubsystem>() : nullptr)
+    {
+        RequestedHiddenActors.Reserve(PreparedHiddenActors.Num());
 
-            UE_LOG(LogTemp, Warning, TEXT("[CameraVolume] After hiding, actor %s is hidden: %s"),
-                *Actor->GetName(),
-                Actor->IsHidden() ? TEXT("YES") : TEXT("NO"));
-        }
-        else
+        for (const TWeakObjectPtr<AActor>& WeakActor : PreparedHiddenActors)
         {
-            UE_LOG(LogTemp, Error, TEXT("[CameraVolume] Invalid actor in HiddenActors list!"));
+            if (AActor* Actor = WeakActor.Get())
+            {
+                // El estado original lo guarda el subsistema; aqu solo pedimos ocultar
+                Visibility->AddHideRequest(Actor, EActorHideReason::CameraVolume);
+                RequestedHiddenActors.Add(Actor);
+            }
         }
     }
+
+    // Lo preparado se consume: la prxima entrada vuelve a resolver HiddenActors
+    PreparedHiddenActors.Reset();
+    PrefetchedStreamingLevels.Reset();
+    bTransitionPrepared = false;
 }
 
 void ACameraVolume::ShowActors()
 {
-    UE_LOG(LogTemp, Warning, TEXT("[CameraVolume] ShowActors called on %s"), *GetName());
+    if (!bIsActive)
+        return;
 
-    for (AActor* Actor : HiddenActors)
+    bIsActive = false;
+
+    UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraVolume] ShowActors called on %s"), *GetName());
+
+    if (UActorVisibilitySubsystem* Visibility = GetWorld() ? GetWorld()->GetSubsystem<UActorVisibilitySubsystem>() : nullptr)
     {
-        if (IsValid(Actor))
+        for (const TWeakObjectPtr<AActor>& WeakActor : RequestedHiddenActors)
         {
-            // Restaurar el estado original de visibilidad
-            bool bWasOriginallyHidden = false;
-            if (OriginalVisibilityState.Contains(Actor))
-            {
-                bWasOriginallyHidden = OriginalVisibilityState[Actor];
-            }
+            // Solo se vuelve a ver si ninguna otra razn (otro volumen, mscara...) lo mantiene oculto
+            Visibility->RemoveHideRequest(WeakActor.Get(), EActorHideReason::CameraVolume);
+        }
+    }
 
-            UE_LOG(LogTemp, Warning, TEXT("[CameraVolume] Showing actor: %s (restore to originally hidden: %s)"),
-                *Actor->GetName(),
-                bWasOriginallyHidden ? TEXT("YES") : TEXT("NO"));
+    RequestedHiddenActors.Reset();
 
-            // Solo mostrar si no estaba oculto originalmente
-            Actor->SetActorHiddenInGame(bWasOriginallyHidden);
+    // Los subniveles del volumen se ocultan/descargan salvo que otro volumen (p.ej. el nuevo) los siga pidiendo
+    if (UCameraVolumeSubsystem* VolumeSub = GetWorld() ? GetWorld()->GetSubsystem<UCameraVolumeSubsystem>() : nullptr)
+    {
+        for (const TWeakObjectPtr<ULevelStreaming>& WeakStreaming : ActiveStreamingLevels)
+        {
+            VolumeSub->ReleaseLevelStreaming(WeakStreaming.Get(), true);
         }
     }
+
+    ActiveStreamingLevels.Reset();
 }
\ No newline at end of file
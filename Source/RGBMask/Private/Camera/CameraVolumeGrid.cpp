@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Camera/CameraVolumeGrid.h"
+#include "Camera/CameraVolume.h"
+
+FCameraVolumeGrid::FCameraVolumeGrid(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 100.0f))
+{
+}
+
+void FCameraVolumeGrid::SetCellSize(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 100.0f);
+	Reset();
+}
+
+void FCameraVolumeGrid::Add(ACameraVolume* Volume)
+{
+	if (!IsValid(Volume))
+		return;
+
+	Remove(Volume);
+
+	const FBox Bounds = Volume->GetCachedBounds();
+	if (!Bounds.IsValid)
+		return;
+
+	const FIntRect Range = GetCellRange(Bounds);
+	VolumeCellRanges.Add(Volume, Range);
+
+	for (int32 X = Range.Min.X; X <= Range.Max.X; ++X)
+	{
+		for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; ++Y)
+		{
+			TArray<TWeakObjectPtr<ACameraVolume>>& Cell = Cells.FindOrAdd(FIntPoint(X, Y));
+
+			// Mantener la celda ordenada por prioridad (mayor primero, empates por orden de llegada)
+			int32 InsertIndex = 0;
+			while (InsertIndex < Cell.Num())
+			{
+				const ACameraVolume* Other = Cell[InsertIndex].Get();
+				if (Other && Other->Priority < Volume->Priority)
+					break;
+				++InsertIndex;
+			}
+			Cell.Insert(Volume, InsertIndex);
+		}
+	}
+
+	++Revision;
+}
+
+void FCameraVolumeGrid::Remove(const ACameraVolume* Volume)
+{
+	FIntRect Range;
+	if (!VolumeCellRanges.RemoveAndCopyValue(Volume, Range))
+		return;
+
+	for (int32 X = Range.Min.X; X <= Range.Max.X; ++X)
+	{
+		for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; ++Y)
+		{
+			const FIntPoint Coord(X, Y);
+			if (TArray<TWeakObjectPtr<ACameraVolume>>* Cell = Cells.Find(Coord))
+			{
+				// De paso limpiamos entradas de volúmenes ya destruidos
+				Cell->RemoveAll([Volume](const TWeakObjectPtr<ACameraVolume>& Entry)
+					{
+						return !Entry.IsValid() || Entry.Get() == Volume;
+					});
+
+				if (Cell->IsEmpty())
+				{
+					Cells.Remove(Coord);
+				}
+			}
+		}
+	}
+
+	++Revision;
+}
+
+void FCameraVolumeGrid::Reset()
+{
+	Cells.Reset();
+	VolumeCellRanges.Reset();
+	++Revision;
+}
+
+FIntPoint FCameraVolumeGrid::GetCellCoord(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+const TArray<TWeakObjectPtr<ACameraVolume>>* FCameraVolumeGrid::FindCell(const FIntPoint& Cell) const
+{
+	return Cells.Find(Cell);
+}
+
+FIntRect FCameraVolumeGrid::GetCellRange(const FBox& Bounds) const
+{
+	return FIntRect(GetCellCoord(Bounds.Min), GetCellCoord(Bounds.Max));
+}
@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Camera/CameraVolumeSubsystem.h"
+#include "Camera/CameraVolume.h"
+#include "Engine/LevelStreaming.h"
+
+void UCameraVolumeSubsystem::Register(ACameraVolume* Volume)
+{
+	if (!IsValid(Volume) || Volumes.Contains(Volume))
+		return;
+
+	// Limpiar volúmenes destruidos sin EndPlay (no debería pasar, pero es barato)
+	Volumes.RemoveAll([](const TWeakObjectPtr<ACameraVolume>& Entry) { return !Entry.IsValid(); });
+
+	// Inserción ordenada: mayor prioridad primero, empates por orden de registro
+	int32 InsertIndex = 0;
+	while (InsertIndex < Volumes.Num() && Volumes[InsertIndex]->Priority >= Volume->Priority)
+	{
+		++InsertIndex;
+	}
+	Volumes.Insert(Volume, InsertIndex);
+
+	Grid.Add(Volume);
+	Volume->OnBoundsChanged.AddUObject(this, &UCameraVolumeSubsystem::OnVolumeBoundsChanged);
+}
+
+void UCameraVolumeSubsystem::Unregister(ACameraVolume* Volume)
+{
+	if (!Volume)
+		return;
+
+	Volumes.Remove(Volume);
+	Grid.Remove(Volume);
+	Volume->OnBoundsChanged.RemoveAll(this);
+}
+
+ACameraVolume* UCameraVolumeSubsystem::GetHighestPriorityVolume() const
+{
+	for (const TWeakObjectPtr<ACameraVolume>& WeakVolume : Volumes)
+	{
+		if (ACameraVolume* Volume = WeakVolume.Get())
+		{
+			return Volume;
+		}
+	}
+
+	return nullptr;
+}
+
+void UCameraVolumeSubsystem::SetGridCellSize(float CellSize)
+{
+	if (FMath::IsNearlyEqual(Grid.GetCellSize(), CellSize))
+		return;
+
+	Grid.SetCellSize(CellSize);
+
+	// Reinsertar en orden de prioridad para conservar los empates
+	for (const TWeakObjectPtr<ACameraVolume>& WeakVolume : Volumes)
+	{
+		if (ACameraVolume* Volume = WeakVolume.Get())
+		{
+			Grid.Add(Volume);
+		}
+	}
+}
+
+void UCameraVolumeSubsystem::RequestLevelStreaming(ULevelStreaming* Level, bool bVisible)
+{
+	if (!Level)
+		return;
+
+	FLevelStreamingRequest* Request = LevelRequests.FindByPredicate([Level](const FLevelStreamingRequest& Entry) { return Entry.Level.Get() == Level; });
+	if (!Request)
+	{
+		Request = &LevelRequests.AddDefaulted_GetRef();
+		Request->Level = Level;
+		Request->bWasLoaded = Level->ShouldBeLoaded();
+		Request->bWasVisible = Level->GetShouldBeVisibleFlag();
+	}
+
+	++Request->LoadCount;
+	if (bVisible)
+	{
+		++Request->VisibleCount;
+	}
+
+	ApplyLevelStreaming(*Request);
+}
+
+void UCameraVolumeSubsystem::ReleaseLevelStreaming(ULevelStreaming* Level, bool bVisible)
+{
+	// Aprovechamos para tirar niveles que ya no existen
+	LevelRequests.RemoveAllSwap([](const FLevelStreamingRequest& Entry) { return !Entry.Level.IsValid(); });
+
+	if (!Level)
+		return;
+
+	const int32 Index = LevelRequests.IndexOfByPredicate([Level](const FLevelStreamingRequest& Entry) { return Entry.Level.Get() == Level; });
+	if (Index == INDEX_NONE)
+		return;
+
+	FLevelStreamingRequest& Request = LevelRequests[Index];
+	Request.LoadCount = FMath::Max(Request.LoadCount - 1, 0);
+	if (bVisible)
+	{
+		Request.VisibleCount = FMath::Max(Request.VisibleCount - 1, 0);
+	}
+
+	ApplyLevelStreaming(Request);
+
+	if (Request.LoadCount == 0)
+	{
+		LevelRequests.RemoveAtSwap(Index);
+	}
+}
+
+void UCameraVolumeSubsystem::ApplyLevelStreaming(const FLevelStreamingRequest& Request) const
+{
+	ULevelStreaming* Level = Request.Level.Get();
+	if (!Level)
+		return;
+
+	Level->SetShouldBeLoaded(Request.LoadCount > 0 || Request.bWasLoaded);
+	Level->SetShouldBeVisible(Request.VisibleCount > 0 || Request.bWasVisible);
+}
+
+void UCameraVolumeSubsystem::OnVolumeBoundsChanged(ACameraVolume* Volume)
+{
+	// Add quita primero las celdas antiguas
+	Grid.Add(Volume);
+}
@@ -2,15 +2,20 @@
 
 
 #include "Camera/RGBMaskCameraManager.h"
-#include "Kismet/GameplayStatics.h"
+#include "Camera/CameraVolumeSubsystem.h"
+#include "Camera/CameraSpring.h"
+#include "RGBMask.h"
 #include "GameFramework/Pawn.h"
 
 ARGBMaskCameraManager::ARGBMaskCameraManager()
 {
     PreviousCameraVolume = nullptr;
     ActiveCameraVolume = nullptr;
+    VolumeSubsystem = nullptr;
     CurrentCameraLocation = FVector::ZeroVector;
     CurrentCameraRotation = FRotator::ZeroRotator;
+    CameraVelocity = FVector::ZeroVector;
+    CameraAngularVelocity = FVector::ZeroVector;
 }
 
 void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
@@ -18,9 +23,10 @@ void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTim
     // Inicializar volumenes si es necesario
     if (!bVolumesInitialized)
     {
-        FindCameraVolumes();
+        InitializeVolumeSubsystem();
         bVolumesInitialized = true;
-        UE_LOG(LogTemp, Warning, TEXT("[CameraManager] Camera volumes initialized, found %d volumes"), CameraVolumes.Num());
+        UE_LOG(LogRGBMaskCamera, Log, TEXT("[CameraManager] Camera volumes initialized, %d volumes registered"),
+            VolumeSubsystem ? VolumeSubsystem->GetVolumes().Num() : 0);
     }
 
 
@@ -28,13 +34,15 @@ void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTim
     APlayerController* PC = GetOwningPlayerController();
     APawn* PlayerPawn = PC ? PC->GetPawn() : nullptr;
     // Si el view target no es el pawn del jugador, dejar que Unreal maneje
-    if (ViewTarget.Target != PlayerPawn || PendingViewTarget.Target != nullptr)
+    if (!PlayerPawn || ViewTarget.Target != PlayerPawn || PendingViewTarget.Target != nullptr)
     {
       Super::UpdateViewTarget(OutVT, DeltaTime);
 
       // Sincronizar posicin
       CurrentCameraLocation = OutVT.POV.Location;
       CurrentCameraRotation = OutVT.POV.Rotation;
+      CameraVelocity = FVector::ZeroVector;
+      CameraAngularVelocity = FVector::ZeroVector;
       bIsTransitioning = false;
 
       return;
@@ -51,23 +59,25 @@ void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTim
         // IMPORTANTE: Iniciar transicin ANTES de cambiar el volumen
         bIsTransitioning = true;
 
-        UE_LOG(LogTemp, Log, TEXT("[CameraManager] Starting transition from volume %s to %s"),
+        UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraManager] Starting transition from volume %s to %s"),
             ActiveCameraVolume ? *ActiveCameraVolume->GetName() : TEXT("None"),
             NewActiveVolume ? *NewActiveVolume->GetName() : TEXT("None"));
 
         HandleVolumeChange(NewActiveVolume);
         ActiveCameraVolume = NewActiveVolume;
     }
+    else if (bPrefetchVolumeTransitions)
+    {
+        PrefetchNextVolume(*PlayerPawn, PlayerLocation);
+    }
 
     // 1) Base SIN modifiers
     Super::UpdateViewTargetInternal(OutVT, DeltaTime);
 
-    // 2) Calcular la posicin OBJETIVO de la cmara (donde queremos estar)
-    FTViewTarget TempVT = OutVT; // Crear una copia temporal
-    ApplyCameraOffset(TempVT, PlayerLocation);
-
-    FVector TargetLocation = TempVT.POV.Location;
-    FRotator TargetRotation = TempVT.POV.Rotation;
+    // 2) Calcular la posicin OBJETIVO de la cmara (donde queremos estar), directamente desde el pawn
+    FVector TargetLocation;
+    FRotator TargetRotation;
+    ComputeCameraOffsetPose(*PlayerPawn, PlayerLocation, TargetLocation, TargetRotation);
 
     // 3) Aplicar clamp al objetivo
     if (ActiveCameraVolume)
@@ -80,29 +90,20 @@ void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTim
         TargetLocation.Y = FMath::Clamp(TargetLocation.Y, MinBounds.Y + Slack, MaxBounds.Y - Slack);
     }
 
-    // 4) Interpolar hacia el objetivo
+    // 4) Muelle crticamente amortiguado hacia el objetivo (independiente del framerate)
     if (bIsTransitioning)
     {
-        // Interpolar desde la ltima posicin conocida
-        CurrentCameraLocation = FMath::VInterpTo(
-            CurrentCameraLocation,
-            TargetLocation,
-            DeltaTime,
-            CameraTransitionSpeed
-        );
+        // Desde la ltima posicin/velocidad conocida
+        CameraSpring::Step(CurrentCameraLocation, CameraVelocity, TargetLocation, CameraTransitionSpeed, DeltaTime);
 
         if (bInterpolateRotation)
         {
-            CurrentCameraRotation = FMath::RInterpTo(
-                CurrentCameraRotation,
-                TargetRotation,
-                DeltaTime,
-                CameraTransitionSpeed
-            );
+            CameraSpring::StepRotator(CurrentCameraRotation, CameraAngularVelocity, TargetRotation, CameraTransitionSpeed, DeltaTime);
         }
         else
         {
             CurrentCameraRotation = TargetRotation;
+            CameraAngularVelocity = FVector::ZeroVector;
         }
 
         // Comprobar si hemos llegado al objetivo
@@ -112,19 +113,22 @@ void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTim
             bIsTransitioning = false;
             CurrentCameraLocation = TargetLocation;
             CurrentCameraRotation = TargetRotation;
-            UE_LOG(LogTemp, Log, TEXT("[CameraManager] Transition completed"));
+            CameraAngularVelocity = FVector::ZeroVector;
+            UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraManager] Transition completed"));
         }
     }
     else
     {
-        // No hay transicin: usar el objetivo directamente pero con interpolacin suave
-        CurrentCameraLocation = FMath::VInterpTo(
+        // No hay transicin: seguir el objetivo con el mismo muelle, ms rgido
+        CameraSpring::Step(
             CurrentCameraLocation,
+            CameraVelocity,
             TargetLocation,
-            DeltaTime,
-            CameraTransitionSpeed * 2.0f // Ms rpido cuando no hay cambio de volumen
+            CameraTransitionSpeed * 2.0f, // Ms rpido cuando no hay cambio de volumen
+            DeltaTime
         );
         CurrentCameraRotation = TargetRotation;
+        CameraAngularVelocity = FVector::ZeroVector;
     }
 
     // 5) Aplicar la posicin interpolada al viewport
@@ -135,43 +139,100 @@ void ARGBMaskCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTim
     ApplyCameraModifiers(DeltaTime, OutVT.POV);
 }
 
-void ARGBMaskCameraManager::FindCameraVolumes()
+void ARGBMaskCameraManager::InitializeVolumeSubsystem()
 {
-	CameraVolumes.Empty();
-
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ACameraVolume::StaticClass(), FoundActors);
-
-	for (AActor* Actor : FoundActors)
+	VolumeSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UCameraVolumeSubsystem>() : nullptr;
+	if (VolumeSubsystem)
 	{
-		ACameraVolume* Volume = Cast<ACameraVolume>(Actor);
-		if (Volume)
-		{
-			CameraVolumes.Add(Volume);
-		}
+		VolumeSubsystem->SetGridCellSize(VolumeGridCellSize);
 	}
-
-	// Ordenar por prioridad (mayor prioridad primero)
-	CameraVolumes.Sort([](const ACameraVolume& A, const ACameraVolume& B) {
-		return A.Priority > B.Priority;
-		});
+	CachedCellVolumes = nullptr;
 }
 
 ACameraVolume* ARGBMaskCameraManager::GetActiveVolume(const FVector& PlayerLocation)
 {
+	if (!VolumeSubsystem)
+		return nullptr;
+
+	// Solo se reconsulta la rejilla al cruzar un borde de celda (o si la rejilla cambia
+	// porque un volumen entra, sale o se mueve)
+	const FCameraVolumeGrid& VolumeGrid = VolumeSubsystem->GetGrid();
+	const FIntPoint Cell = VolumeGrid.GetCellCoord(PlayerLocation);
+	if (Cell != CachedCell || CachedGridRevision != VolumeGrid.GetRevision())
+	{
+		CachedCell = Cell;
+		CachedGridRevision = VolumeGrid.GetRevision();
+		CachedCellVolumes = VolumeGrid.FindCell(Cell);
+	}
+
 	// Buscar el volumen de mayor prioridad que contenga al jugador
-	for (ACameraVolume* Volume : CameraVolumes)
+	if (CachedCellVolumes)
 	{
-		if (Volume && Volume->IsLocationInsideVolume(PlayerLocation))
+		for (const TWeakObjectPtr<ACameraVolume>& WeakVolume : *CachedCellVolumes)
 		{
-			return Volume;
+			ACameraVolume* Volume = WeakVolume.Get();
+			if (Volume && Volume->IsLocationInsideVolume(PlayerLocation))
+			{
+				return Volume;
+			}
 		}
 	}
 
 	// Si el jugador no esta en ningun volumen, usar el primero disponible
-	if (CameraVolumes.Num() > 0)
+	return VolumeSubsystem->GetHighestPriorityVolume();
+}
+
+void ARGBMaskCameraManager::PrefetchNextVolume(const APawn& PlayerPawn, const FVector& PlayerLocation)
+{
+	ACameraVolume* PredictedVolume = PredictNextVolume(PlayerPawn, PlayerLocation);
+
+	// Solo una vez por volumen predicho
+	ACameraVolume* StaleVolume = PrefetchedCameraVolume.Get();
+	if (PredictedVolume == StaleVolume)
+		return;
+
+	// La prediccin ha cambiado (otro volumen, o ninguno: parado, de vuelta al activo...):
+	// soltar lo que se prepar para el anterior para no dejar sus subniveles cargados
+	if (StaleVolume)
+	{
+		UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraManager] Cancelling prefetched transition to %s"), *StaleVolume->GetName());
+		StaleVolume->CancelTransition();
+	}
+
+	PrefetchedCameraVolume = PredictedVolume;
+
+	if (PredictedVolume)
+	{
+		UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraManager] Prefetching transition to %s"), *PredictedVolume->GetName());
+		PredictedVolume->PrepareTransition();
+	}
+}
+
+ACameraVolume* ARGBMaskCameraManager::PredictNextVolume(const APawn& PlayerPawn, const FVector& PlayerLocation) const
+{
+	if (!VolumeSubsystem || TransitionPrefetchLookahead <= 0.f)
+		return nullptr;
+
+	const FVector Velocity = PlayerPawn.GetVelocity();
+	if (Velocity.SizeSquared2D() < FMath::Square(10.f))
+		return nullptr;
+
+	// Posicin estimada dentro de TransitionPrefetchLookahead segundos
+	const FVector PredictedLocation = PlayerLocation + Velocity * TransitionPrefetchLookahead;
+
+	const FCameraVolumeGrid& VolumeGrid = VolumeSubsystem->GetGrid();
+	const TArray<TWeakObjectPtr<ACameraVolume>>* Candidates = VolumeGrid.FindCell(VolumeGrid.GetCellCoord(PredictedLocation));
+	if (!Candidates)
+		return nullptr;
+
+	for (const TWeakObjectPtr<ACameraVolume>& WeakVolume : *Candidates)
 	{
-		return CameraVolumes[0];
+		ACameraVolume* Volume = WeakVolume.Get();
+		if (Volume && Volume->IsLocationInsideVolume(PredictedLocation))
+		{
+			// Solo el de mayor prioridad; si es el activo no hay transicin que preparar
+			return Volume != ActiveCameraVolume ? Volume : nullptr;
+		}
 	}
 
 	return nullptr;
@@ -191,19 +252,15 @@ void ARGBMaskCameraManager::ClampCameraToVolume(FVector& CameraLocation)
 	// Z no se clampea para mantener la altura original
 }
 
-void ARGBMaskCameraManager::ApplyCameraOffset(FTViewTarget& OutVT, const FVector& PlayerLocation)
+void ARGBMaskCameraManager::ComputeCameraOffsetPose(const APawn& PlayerPawn, const FVector& PlayerLocation, FVector& OutLocation, FRotator& OutRotation) const
 {
-	APawn* PlayerPawn = GetOwningPlayerController()->GetPawn();
-	if (!PlayerPawn)
-		return;
-
 	// Determinar la direccion hacia atras
 	FVector BackwardDirection;
 
 	if (bUsePlayerForwardForOffset)
 	{
 		// Usar el forward del jugador (la camara seguira la orientacion del personaje)
-		FRotator PlayerRotation = PlayerPawn->GetActorRotation();
+		FRotator PlayerRotation = PlayerPawn.GetActorRotation();
 		BackwardDirection = -PlayerRotation.Vector(); // Negativo porque queremos ir hacia atras
 	}
 	else
@@ -226,7 +283,7 @@ void ARGBMaskCameraManager::ApplyCameraOffset(FTViewTarget& OutVT, const FVector
 	TargetCameraLocation.Z += CameraHeightOffset;
 
 	// Actualizar la posicion de la camara
-	OutVT.POV.Location = TargetCameraLocation;
+	OutLocation = TargetCameraLocation;
 
 	// Calcular la rotacion de la camara para que mire al jugador
 	FVector DirectionToPlayer = PlayerLocation - TargetCameraLocation;
@@ -238,24 +295,34 @@ void ARGBMaskCameraManager::ApplyCameraOffset(FTViewTarget& OutVT, const FVector
 		CameraRotation.Pitch = CameraPitchAngle;
 	}
 
-	OutVT.POV.Rotation = CameraRotation;
+	OutRotation = CameraRotation;
 }
 
 void ARGBMaskCameraManager::HandleVolumeChange(ACameraVolume* NewVolume)
 {
 
-	// Restaurar visibilidad del volumen anterior
-	if (PreviousCameraVolume && PreviousCameraVolume != NewVolume)
+	// Se ha entrado en un volumen distinto al predicho: descartar la preparacin
+	ACameraVolume* StaleVolume = PrefetchedCameraVolume.Get();
+	if (StaleVolume && StaleVolume != NewVolume)
 	{
-		PreviousCameraVolume->ShowActors();
+		StaleVolume->CancelTransition();
 	}
+	PrefetchedCameraVolume.Reset();
 
-	// Ocultar actores del nuevo volumen
+	// Ocultar actores del nuevo volumen.
+	// Antes de soltar el anterior: un subnivel que compartan no llega a ocultarse/descargarse entre medias
 	if (NewVolume)
 	{
 		NewVolume->HideActors();
 	}
 
+	// Restaurar visibilidad del volumen anterior
+	// (IsValid: el volumen anterior puede haberse descargado con su subnivel)
+	if (IsValid(PreviousCameraVolume) && PreviousCameraVolume != NewVolume)
+	{
+		PreviousCameraVolume->ShowActors();
+	}
+
 	// Actualizar el volumen anterior
 	PreviousCameraVolume = NewVolume;
 }
\ No newline at end of file
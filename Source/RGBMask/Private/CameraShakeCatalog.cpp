@@ -0,0 +1,42 @@
+#include "CameraShakeCatalog.h"
+#include "Camera/CameraShakeBase.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+
+#define LOCTEXT_NAMESPACE "CameraShakeCatalog"
+
+EDataValidationResult UCameraShakeCatalog::IsDataValid(FDataValidationContext& Context) const
+{
+    EDataValidationResult Result = Super::IsDataValid(Context);
+
+    // Tags duplicados harían que uno de los perfiles fuera inalcanzable
+    TSet<FName> SeenTags;
+    for (int32 Index = 0; Index < Profiles.Num(); ++Index)
+    {
+        const FCameraShakeProfile& Profile = Profiles[Index];
+
+        if (Profile.Tag.IsNone())
+        {
+            Context.AddError(FText::Format(LOCTEXT("MissingTag", "Profile {0} has no Tag."), Index));
+            Result = EDataValidationResult::Invalid;
+        }
+        else if (SeenTags.Contains(Profile.Tag))
+        {
+            Context.AddError(FText::Format(LOCTEXT("DuplicateTag", "Tag '{0}' is used by more than one profile."), FText::FromName(Profile.Tag)));
+            Result = EDataValidationResult::Invalid;
+        }
+        SeenTags.Add(Profile.Tag);
+
+        if (!Profile.ShakeClass)
+        {
+            Context.AddError(FText::Format(LOCTEXT("MissingClass", "Profile '{0}' has no ShakeClass."), FText::FromName(Profile.Tag)));
+            Result = EDataValidationResult::Invalid;
+        }
+    }
+
+    return Result;
+}
+
+#undef LOCTEXT_NAMESPACE
+#endif
@@ -4,6 +4,7 @@
 #include "Camera/PlayerCameraManager.h"
 #include "RGBMaskPlayerController.h"
 #include "Camera/CameraShakeBase.h"
+#include "RGBMask.h"
 
 UCameraShakeSubsystem::UCameraShakeSubsystem()
 {
@@ -17,6 +18,105 @@ UCameraShakeSubsystem::UCameraShakeSubsystem()
     }
 }
 
+void UCameraShakeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Carga sncrona una vez por mundo: el catlogo es pequeo y solo referencia clases
+    Catalog = CatalogAsset.IsNull() ? nullptr : CatalogAsset.LoadSynchronous();
+    RebuildProfiles();
+}
+
+void UCameraShakeSubsystem::SetCatalog(UCameraShakeCatalog* NewCatalog)
+{
+    Catalog = NewCatalog;
+    RebuildProfiles();
+}
+
+void UCameraShakeSubsystem::RebuildProfiles()
+{
+    Profiles.Reset();
+    ProfileIdByTag.Reset();
+
+    // Perfil por defecto: mismos valores que el PlayShake de siempre
+    FCameraShakeProfile& Default = Profiles.AddDefaulted_GetRef();
+    Default.Tag = TEXT("Default");
+    Default.ShakeClass = DefaultImpactShake;
+    ProfileIdByTag.Add(Default.Tag, DefaultProfileId);
+
+    if (Catalog)
+    {
+        for (const FCameraShakeProfile& Profile : Catalog->Profiles)
+        {
+            if (Profile.Tag.IsNone())
+            {
+                UE_LOG(LogRGBMaskCamera, Warning, TEXT("[CameraShake] Catalog %s has a profile without Tag, ignored"), *Catalog->GetName());
+                continue;
+            }
+
+            // Un perfil "Default" en el catlogo sustituye al integrado
+            if (const int32* ExistingId = ProfileIdByTag.Find(Profile.Tag))
+            {
+                Profiles[*ExistingId] = Profile;
+                continue;
+            }
+
+            ProfileIdByTag.Add(Profile.Tag, Profiles.Add(Profile));
+        }
+    }
+
+    Cooldowns.Reset();
+    Cooldowns.SetNum(Profiles.Num());
+
+    // Las peticiones encoladas apuntan a ids del catlogo anterior
+    PendingShakes.Reset();
+    PendingOverrides.Reset();
+    ActiveBuckets.Reset();
+    Buckets.Reset();
+    Buckets.SetNum(Profiles.Num());
+
+    UE_LOG(LogRGBMaskCamera, Log, TEXT("[CameraShake] %d shake profiles registered"), Profiles.Num());
+}
+
+int32 UCameraShakeSubsystem::FindProfileId(FName Tag) const
+{
+    const int32* Id = ProfileIdByTag.Find(Tag);
+    return Id ? *Id : INDEX_NONE;
+}
+
+bool UCameraShakeSubsystem::PlayShakeByTag(FName Tag, FVector WorldSource, float ScaleMultiplier, const UObject* Source)
+{
+    int32 ProfileId = FindProfileId(Tag);
+    if (ProfileId == INDEX_NONE)
+    {
+        UE_LOG(LogRGBMaskCamera, Verbose, TEXT("[CameraShake] Unknown shake profile '%s', using Default"), *Tag.ToString());
+        ProfileId = DefaultProfileId;
+    }
+
+    return PlayShakeProfile(ProfileId, WorldSource, ScaleMultiplier, Source);
+}
+
+bool UCameraShakeSubsystem::PlayShakeProfile(int32 ProfileId, FVector WorldSource, float ScaleMultiplier, const UObject* Source)
+{
+    UWorld* World = GetWorld();
+    if (!World || !Profiles.IsValidIndex(ProfileId)) return false;
+
+    const FCameraShakeProfile& Profile = Profiles[ProfileId];
+
+    // Filtro barato antes de encolar: si ya est en cooldown no ocupa sitio en la cola
+    if (IsOnCooldown(ProfileId, Profile.CooldownSeconds, Profile.bCooldownPerSource ? Source : nullptr, World->GetTimeSeconds()))
+    {
+        return false;
+    }
+
+    FPendingShake& Request = PendingShakes.AddDefaulted_GetRef();
+    Request.ProfileId = ProfileId;
+    Request.Scale = Profile.DefaultScale * ScaleMultiplier;
+    Request.WorldSource = WorldSource;
+    Request.Source = Profile.bCooldownPerSource ? Source : nullptr;
+    return true;
+}
+
 void UCameraShakeSubsystem::PlayShake(
     float Scale,
     float CooldownSeconds,
@@ -35,80 +135,340 @@ void UCameraShakeSubsystem::PlayShake(
     UWorld* World = GetWorld();
     if (!World || !DefaultImpactShake) return;
 
-    // Cooldown por shake (y de paso evita spamear la vibracin tambin)
+    // Cooldown compartido con el perfil por defecto (misma clase de shake)
+    if (IsOnCooldown(DefaultProfileId, CooldownSeconds, nullptr, World->GetTimeSeconds()))
+    {
+        return;
+    }
+
+    FCameraShakeProfile& Params = PendingOverrides.AddDefaulted_GetRef();
+    Params.ShakeClass = DefaultImpactShake;
+    Params.InnerRadius = InnerRadius;
+    Params.OuterRadius = OuterRadius;
+    Params.MinScale = MinScale;
+    Params.MaxScale = MaxScale;
+    Params.MaxMergedScale = MaxScale;
+    Params.bPlayRumble = bPlayRumble;
+    Params.RumbleIntensity = RumbleIntensity;
+    Params.RumbleDuration = RumbleDuration;
+    Params.MinRumble = MinRumble;
+    Params.MaxRumble = MaxRumble;
+    Params.CooldownSeconds = CooldownSeconds;
+
+    // Se fusiona con las peticiones del perfil por defecto
+    FPendingShake& Request = PendingShakes.AddDefaulted_GetRef();
+    Request.ProfileId = DefaultProfileId;
+    Request.OverrideIndex = PendingOverrides.Num() - 1;
+    Request.Scale = Scale;
+    Request.WorldSource = WorldSource;
+}
+
+void UCameraShakeSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (PendingShakes.Num() > 0)
+    {
+        Flush();
+    }
+}
+
+TStatId UCameraShakeSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCameraShakeSubsystem, STATGROUP_Tickables);
+}
+
+void UCameraShakeSubsystem::CacheLocalViews()
+{
+    LocalViews.Reset();
+
+    UWorld* World = GetWorld();
+    if (!World) return;
+
+    // Una consulta al camera manager por jugador local y frame, no por peticin
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        if (!PC || !PC->IsLocalController() || !PC->PlayerCameraManager) continue;
+
+        FLocalView& View = LocalViews.AddDefaulted_GetRef();
+        View.PlayerController = PC;
+        View.CameraLocation = PC->PlayerCameraManager->GetCameraLocation();
+    }
+}
+
+void UCameraShakeSubsystem::Flush()
+{
+    UWorld* World = GetWorld();
+    if (World)
+    {
+        CacheLocalViews();
+    }
+
+    if (LocalViews.Num() == 0)
+    {
+        PendingShakes.Reset();
+        PendingOverrides.Reset();
+        return;
+    }
+
     const double Now = World->GetTimeSeconds();
-    if (CooldownSeconds > 0.f)
+
+    // --- 0) Cooldown por fuente: se decide una vez por peticin, no por jugador ---
+    int32 NumAccepted = 0;
+    for (FPendingShake& Request : PendingShakes)
     {
-        const double* LastPtr = LastPlayTimeByShake.Find(DefaultImpactShake);
-        if (LastPtr && (Now - *LastPtr) < CooldownSeconds)
+        if (!Buckets.IsValidIndex(Request.ProfileId)) continue;
+
+        const FCameraShakeProfile& Profile = GetRequestProfile(Request);
+
+        // La fuente puede haberse destruido desde que pidi el shake; el shake sigue valiendo
+        if (const UObject* Source = Request.Source.Get())
         {
-            return;
+            if (IsOnCooldown(Request.ProfileId, Profile.CooldownSeconds, Source, Now)) continue;
+
+            // El cooldown an no se marca (depende de que el bucket se lance), as que una misma
+            // fuente solo cuenta una vez por perfil y frame. Pocas peticiones por frame: bsqueda lineal
+            if (Profile.CooldownSeconds > 0.f && IsSourceAccepted(Request.ProfileId, Source, NumAccepted)) continue;
+        }
+
+        PendingShakes[NumAccepted++] = Request;
+    }
+    const int32 NumRequests = PendingShakes.Num();
+    PendingShakes.SetNum(NumAccepted, EAllowShrinking::No);
+
+    // --- 1..3) Por cada vista local: fusionar, priorizar y lanzar ---
+    int32 NumStarted = 0;
+    for (const FLocalView& View : LocalViews)
+    {
+        APlayerController* PC = View.PlayerController.Get();
+        if (!PC || !PC->PlayerCameraManager) continue;
+
+        NumStarted += ResolveForView(*PC, View.CameraLocation, Now);
+    }
+
+    // --- 4) Cooldown por fuente solo de lo que se ha lanzado de verdad ---
+    // (un bucket descartado por MaxShakesPerFrame no debe silenciar a su fuente)
+    for (const FPendingShake& Request : PendingShakes)
+    {
+        FShakeBucket& Bucket = Buckets[Request.ProfileId];
+        if (!Bucket.bPlayed) continue;
+
+        const UObject* Source = Request.Source.Get();
+        if (Source && GetRequestProfile(Request).CooldownSeconds > 0.f)
+        {
+            MarkPlayed(Request.ProfileId, Source, Now);
         }
     }
+    for (const FPendingShake& Request : PendingShakes)
+    {
+        Buckets[Request.ProfileId].bPlayed = false;
+    }
 
-    APlayerController* PC0 = UGameplayStatics::GetPlayerController(World, 0);
-    if (!PC0 || !PC0->IsLocalController() || !PC0->PlayerCameraManager) return;
+    UE_LOG(LogRGBMaskCamera, VeryVerbose, TEXT("[CameraShake] Resolved %d requests into %d shakes for %d local players"),
+        NumRequests, NumStarted, LocalViews.Num());
 
-    float FinalScale = Scale;
+    PendingShakes.Reset();
+    PendingOverrides.Reset();
+}
 
-    // Falloff por distancia si OuterRadius > InnerRadius y WorldSource vlido
-    const bool bUseFalloff =
-        !WorldSource.IsNearlyZero() &&
-        (OuterRadius > InnerRadius) &&
-        (OuterRadius > 0.f);
+int32 UCameraShakeSubsystem::ResolveForView(APlayerController& PC, const FVector& CamLoc, double Now)
+{
+    // Rumble: una sola actualizacin por frame y jugador con la peticin ms fuerte
+    float FrameRumble = 0.f;
+    float FrameRumbleDuration = 0.f;
 
-    float Falloff = 1.f; // 1 => sin falloff
-    if (bUseFalloff)
+    // --- 1) Fusionar por perfil (el falloff depende de la cmara de este jugador) ---
+    for (const FPendingShake& Request : PendingShakes)
     {
-        const FVector CamLoc = PC0->PlayerCameraManager->GetCameraLocation();
-        const float Dist = FVector::Dist(CamLoc, WorldSource);
+        const FCameraShakeProfile& Profile = GetRequestProfile(Request);
 
-        // Dist <= inner => 1; Dist >= outer => 0
-        const float Alpha = FMath::Clamp((Dist - InnerRadius) / (OuterRadius - InnerRadius), 0.f, 1.f);
-        Falloff = 1.f - Alpha;
+        const float Falloff = ComputeFalloff(Profile, Request.WorldSource, CamLoc);
+        const float Scale = Request.Scale * Falloff;
+        if (Scale <= KINDA_SMALL_NUMBER) continue;
 
-        FinalScale *= Falloff;
+        FShakeBucket& Bucket = Buckets[Request.ProfileId];
+        if (!Bucket.bActive)
+        {
+            Bucket.bActive = true;
+            Bucket.Profile = &Profile;
+            Bucket.Scale = 0.f;
+            Bucket.CooldownSeconds = 0.f;
+            ActiveBuckets.Add(Request.ProfileId);
+        }
+
+        if (Profile.MergeMode == ECameraShakeMergeMode::Sum)
+        {
+            Bucket.Scale = FMath::Min(Bucket.Scale + Scale, Profile.MaxMergedScale);
+        }
+        else if (Scale > Bucket.Scale)
+        {
+            // La peticin ms fuerte decide los parmetros (clamps) del shake resultante
+            Bucket.Scale = Scale;
+            Bucket.Profile = &Profile;
+        }
+        Bucket.CooldownSeconds = FMath::Max(Bucket.CooldownSeconds, Profile.CooldownSeconds);
+
+        if (Profile.bPlayRumble && Profile.RumbleDuration > KINDA_SMALL_NUMBER)
+        {
+            const float Rumble = FMath::Clamp(Profile.RumbleIntensity * Falloff, Profile.MinRumble, Profile.MaxRumble);
+            if (Rumble > FrameRumble)
+            {
+                FrameRumble = Rumble;
+            }
+            FrameRumbleDuration = FMath::Max(FrameRumbleDuration, Profile.RumbleDuration);
+        }
     }
 
-    FinalScale = FMath::Clamp(FinalScale, MinScale, MaxScale);
-    if (FinalScale <= KINDA_SMALL_NUMBER) return;
+    // --- 2) Prioridad: solo los MaxShakesPerFrame perfiles ms importantes ---
+    ActiveBuckets.Sort([this](int32 A, int32 B)
+    {
+        const FShakeBucket& BucketA = Buckets[A];
+        const FShakeBucket& BucketB = Buckets[B];
+        if (BucketA.Profile->Priority != BucketB.Profile->Priority)
+        {
+            return BucketA.Profile->Priority > BucketB.Profile->Priority;
+        }
+        return BucketA.Scale > BucketB.Scale;
+    });
 
-    // --- Camera shake ---
-    PC0->PlayerCameraManager->StartCameraShake(DefaultImpactShake, FinalScale);
+    int32 NumStarted = 0;
+    for (const int32 ProfileId : ActiveBuckets)
+    {
+        FShakeBucket& Bucket = Buckets[ProfileId];
+        Bucket.bActive = false;
 
-    // --- Gamepad rumble (a todos los motores por igual) ---
+        if (NumStarted >= MaxShakesPerFrame || !Bucket.Profile->ShakeClass) continue;
+
+        const float FinalScale = FMath::Clamp(Bucket.Scale, Bucket.Profile->MinScale, Bucket.Profile->MaxScale);
+        if (FinalScale <= KINDA_SMALL_NUMBER) continue;
+
+        // --- Camera shake ---
+        PC.PlayerCameraManager->StartCameraShake(Bucket.Profile->ShakeClass, FinalScale);
+        Bucket.bPlayed = true;
+        ++NumStarted;
+
+        // Cooldown compartido: basta con que lo haya visto un jugador
+        if (Bucket.CooldownSeconds > 0.f)
+        {
+            MarkPlayed(ProfileId, nullptr, Now);
+        }
+    }
+    ActiveBuckets.Reset();
+
+    // --- 3) Gamepad rumble (a todos los motores por igual) ---
     // Intensidad 0..1. Si no hay mando/rumble, no pasa nada (simplemente no vibra).
-    if (bPlayRumble && RumbleDuration > KINDA_SMALL_NUMBER)
+    if (FrameRumble > KINDA_SMALL_NUMBER)
+    {
+        FDynamicForceFeedbackHandle Handle{}; 
+        PC.PlayDynamicForceFeedback(
+            FrameRumble,
+            FrameRumbleDuration,
+            true,  // Left Large
+            true,  // Left Small
+            true,  // Right Large
+            true,  // Right Small
+            EDynamicForceFeedbackAction::Start,
+            Handle
+        );
+    }
+
+    return NumStarted;
+}
+
+const FCameraShakeProfile& UCameraShakeSubsystem::GetRequestProfile(const FPendingShake& Request) const
+{
+    return PendingOverrides.IsValidIndex(Request.OverrideIndex)
+        ? PendingOverrides[Request.OverrideIndex]
+        : Profiles[Request.ProfileId];
+}
+
+bool UCameraShakeSubsystem::IsOnCooldown(int32 ProfileId, float CooldownSeconds, const UObject* Source, double Now)
+{
+    if (CooldownSeconds <= 0.f || !Cooldowns.IsValidIndex(ProfileId))
+    {
+        return false;
+    }
+
+    FProfileCooldown& Cooldown = Cooldowns[ProfileId];
+    if (!Source)
     {
-        float FinalRumble = RumbleIntensity;
+        return (Now - Cooldown.LastPlayTime) < CooldownSeconds;
+    }
 
-        if (bUseFalloff)
+    // Aprovechamos el recorrido para tirar las fuentes destruidas o ya caducadas
+    bool bOnCooldown = false;
+    for (int32 Index = Cooldown.BySource.Num() - 1; Index >= 0; --Index)
+    {
+        const FSourceCooldown& Entry = Cooldown.BySource[Index];
+        const bool bExpired = (Now - Entry.LastPlayTime) >= CooldownSeconds;
+        if (!Entry.Source.IsValid() || bExpired)
         {
-            FinalRumble *= Falloff;
+            Cooldown.BySource.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+            continue;
         }
+        if (Entry.Source.Get() == Source)
+        {
+            bOnCooldown = true;
+        }
+    }
+    return bOnCooldown;
+}
 
-        FinalRumble = FMath::Clamp(FinalRumble, MinRumble, MaxRumble);
-
-        if (FinalRumble > KINDA_SMALL_NUMBER)
+bool UCameraShakeSubsystem::IsSourceAccepted(int32 ProfileId, const UObject* Source, int32 NumAccepted) const
+{
+    for (int32 Index = 0; Index < NumAccepted; ++Index)
+    {
+        const FPendingShake& Accepted = PendingShakes[Index];
+        if (Accepted.ProfileId == ProfileId && Accepted.Source.Get() == Source)
         {
-            FDynamicForceFeedbackHandle Handle{}; 
-            PC0->PlayDynamicForceFeedback(
-                FinalRumble,
-                RumbleDuration,
-                true,  // Left Large
-                true,  // Left Small
-                true,  // Right Large
-                true,  // Right Small
-                EDynamicForceFeedbackAction::Start,
-                Handle
-            );
+            return true;
         }
     }
+    return false;
+}
 
-    if (CooldownSeconds > 0.f)
+void UCameraShakeSubsystem::MarkPlayed(int32 ProfileId, const UObject* Source, double Now)
+{
+    if (!Cooldowns.IsValidIndex(ProfileId))
+    {
+        return;
+    }
+
+    FProfileCooldown& Cooldown = Cooldowns[ProfileId];
+    if (!Source)
+    {
+        Cooldown.LastPlayTime = Now;
+        return;
+    }
+
+    for (FSourceCooldown& Entry : Cooldown.BySource)
     {
-        LastPlayTimeByShake.Add(DefaultImpactShake, Now);
+        if (Entry.Source.Get() == Source)
+        {
+            Entry.LastPlayTime = Now;
+            return;
+        }
     }
+    Cooldown.BySource.Add({ Source, Now });
 }
 
+float UCameraShakeSubsystem::ComputeFalloff(const FCameraShakeProfile& Profile, const FVector& WorldSource, const FVector& CameraLocation)
+{
+    // Falloff por distancia si OuterRadius > InnerRadius y WorldSource vlido
+    const bool bUseFalloff =
+        !WorldSource.IsNearlyZero() &&
+        (Profile.OuterRadius > Profile.InnerRadius) &&
+        (Profile.OuterRadius > 0.f);
 
+    if (!bUseFalloff)
+    {
+        return 1.f;
+    }
+
+    const float Dist = FVector::Dist(CameraLocation, WorldSource);
+
+    // Dist <= inner => 1; Dist >= outer => 0
+    const float Alpha = FMath::Clamp((Dist - Profile.InnerRadius) / (Profile.OuterRadius - Profile.InnerRadius), 0.f, 1.f);
+    return 1.f - Alpha;
+}
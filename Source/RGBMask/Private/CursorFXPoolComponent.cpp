@@ -0,0 +1,106 @@
+#include "CursorFXPoolComponent.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_STATS_GROUP(TEXT("CursorFX"), STATGROUP_CursorFX, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor FX Plays"), STAT_CursorFXPlays, STATGROUP_CursorFX);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cursor FX Components Created"), STAT_CursorFXComponentsCreated, STATGROUP_CursorFX);
+
+UCursorFXPoolComponent::UCursorFXPoolComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+UCursorFXPoolComponent::FFXRing& UCursorFXPoolComponent::FindOrAddRing(UNiagaraSystem* System)
+{
+	for (FFXRing& Ring : Rings)
+	{
+		if (Ring.System == System)
+		{
+			return Ring;
+		}
+	}
+
+	FFXRing& Ring = Rings.AddDefaulted_GetRef();
+	Ring.System = System;
+	Ring.Components.Reserve(RingSize);
+	return Ring;
+}
+
+UNiagaraComponent* UCursorFXPoolComponent::CreateComponent(UNiagaraSystem* System)
+{
+	AActor* Owner = GetOwner();
+	if (!Owner) return nullptr;
+
+	UNiagaraComponent* Component = NewObject<UNiagaraComponent>(Owner);
+	Component->SetAsset(System);
+	Component->SetAutoActivate(false);
+	Component->SetAutoDestroy(false);
+
+	// Sin attach: se coloca en mundo en cada PlayAt
+	Component->SetUsingAbsoluteLocation(true);
+	Component->SetUsingAbsoluteRotation(true);
+	Component->SetUsingAbsoluteScale(true);
+	Component->RegisterComponent();
+
+	AllComponents.Add(Component);
+	INC_DWORD_STAT(STAT_CursorFXComponentsCreated);
+	return Component;
+}
+
+void UCursorFXPoolComponent::Prewarm(UNiagaraSystem* System)
+{
+	if (!System) return;
+
+	FFXRing& Ring = FindOrAddRing(System);
+	while (Ring.Components.Num() < RingSize)
+	{
+		UNiagaraComponent* Component = CreateComponent(System);
+		if (!Component) return;
+		Ring.Components.Add(Component);
+	}
+}
+
+bool UCursorFXPoolComponent::PlayAt(UNiagaraSystem* System, FVector Location)
+{
+	if (!System) return false;
+
+	FFXRing& Ring = FindOrAddRing(System);
+
+	// Se llena el anillo hasta RingSize; después se reutiliza siempre el más antiguo
+	UNiagaraComponent* Component = nullptr;
+	if (Ring.Components.Num() < RingSize)
+	{
+		Component = CreateComponent(System);
+		if (!Component) return false;
+		Ring.Components.Add(Component);
+		Ring.Next = 0;
+	}
+	else
+	{
+		Component = Ring.Components[Ring.Next];
+		Ring.Next = (Ring.Next + 1) % Ring.Components.Num();
+	}
+
+	Component->SetWorldLocation(Location);
+	Component->Activate(true); // reset: reinicia el efecto aunque siguiera vivo
+
+	INC_DWORD_STAT(STAT_CursorFXPlays);
+	return true;
+}
+
+void UCursorFXPoolComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UNiagaraComponent* Component : AllComponents)
+	{
+		if (IsValid(Component))
+		{
+			Component->DestroyComponent();
+		}
+	}
+	AllComponents.Reset();
+	Rings.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
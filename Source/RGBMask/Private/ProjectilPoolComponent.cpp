@@ -1,6 +1,7 @@
 #include "ProjectilPoolComponent.h"
 #include "MaskVisibilitySubsystem.h"
 #include "MaskVisibilityComponent.h"
+#include "ActorVisibilitySubsystem.h"
 
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
@@ -97,7 +98,11 @@ void UProjectilPoolComponent::ReleaseProjectile(AActor* Projectile)
 
 void UProjectilPoolComponent::DeactivateProjectile(AActor* Projectile)
 {
-	Projectile->SetActorHiddenInGame(true);
+	// Hidden while pooled (Gameplay reason, so it composes with the mask's own hide request)
+	if (UActorVisibilitySubsystem* Visibility = GetWorld() ? GetWorld()->GetSubsystem<UActorVisibilitySubsystem>() : nullptr)
+	{
+		Visibility->AddHideRequest(Projectile, EActorHideReason::Gameplay);
+	}
 	Projectile->SetActorEnableCollision(false);
 	Projectile->SetActorTickEnabled(false);
 
@@ -127,6 +132,12 @@ void UProjectilPoolComponent::ActivateProjectile(AActor* Projectile, const FProj
 		}
 	}
 
+	// Drop the pooled hide request; the mask system decides the rest
+	if (UActorVisibilitySubsystem* Visibility = GetWorld() ? GetWorld()->GetSubsystem<UActorVisibilitySubsystem>() : nullptr)
+	{
+		Visibility->RemoveHideRequest(Projectile, EActorHideReason::Gameplay);
+	}
+
 	// Place projectile
 	Projectile->SetActorTransform(Params.SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
 
@@ -157,8 +168,8 @@ void UProjectilPoolComponent::ActivateProjectile(AActor* Projectile, const FProj
 			}
 			else
 			{
-				// Fallback: if projectile has no mask component, at least make it visible/collidable
-				Projectile->SetActorHiddenInGame(false);
+				// Fallback: if projectile has no mask component, at least make it collidable
+				// (visibility already follows the released Gameplay request)
 				Projectile->SetActorEnableCollision(true);
 			}
 		}
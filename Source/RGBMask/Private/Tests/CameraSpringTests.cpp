@@ -0,0 +1,152 @@
+#include "Misc/AutomationTest.h"
+#include "Camera/CameraSpring.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CameraSpringTests
+{
+	constexpr double Omega = 8.0;
+	constexpr double Duration = 4.0;
+
+	// Todas las frecuencias se muestrean en múltiplos de 1/30 s para poder compararlas
+	constexpr int32 SampleRate = 30;
+	constexpr int32 TestRates[] = { 30, 60, 240 };
+	constexpr int32 ReferenceRate = 240;
+
+	struct FSample
+	{
+		FVector Location;
+		FRotator Rotation;
+	};
+
+	/** Trayectoria sintética del pawn: posición/rotación objetivo de la cámara en el instante t */
+	struct FPawnPath
+	{
+		const TCHAR* Name;
+		TFunction<FVector(double)> Location;
+		TFunction<FRotator(double)> Rotation;
+
+		// Velocidad máxima del objetivo (uu/s y grados/s): fija la tolerancia entre frecuencias
+		double Speed;
+		double AngularSpeed;
+	};
+
+	TArray<FSample> Simulate(const FPawnPath& Path, int32 Rate, double SpringOmega = Omega)
+	{
+		FVector Location = Path.Location(0.0);
+		FVector Velocity = FVector::ZeroVector;
+		FRotator Rotation = Path.Rotation(0.0);
+		FVector AngularVelocity = FVector::ZeroVector;
+
+		const double DeltaTime = 1.0 / Rate;
+		const int32 StepsPerSample = Rate / SampleRate;
+		const int32 NumSteps = FMath::RoundToInt(Duration * Rate);
+
+		TArray<FSample> Samples;
+		Samples.Reserve(NumSteps / StepsPerSample);
+
+		for (int32 StepIndex = 1; StepIndex <= NumSteps; ++StepIndex)
+		{
+			// Como el camera manager: el objetivo se lee del pawn una vez por frame
+			const double Time = StepIndex * DeltaTime;
+			CameraSpring::Step(Location, Velocity, Path.Location(Time), SpringOmega, DeltaTime);
+			CameraSpring::StepRotator(Rotation, AngularVelocity, Path.Rotation(Time), SpringOmega, DeltaTime);
+
+			if (StepIndex % StepsPerSample == 0)
+			{
+				Samples.Add({ Location, Rotation });
+			}
+		}
+
+		return Samples;
+	}
+
+	TArray<FPawnPath> MakePaths()
+	{
+		TArray<FPawnPath> Paths;
+
+		// Escalón: el pawn aparece en otro sitio y se queda quieto (cambio de volumen).
+		// Yaw cruza ±180 para cubrir el camino angular más corto
+		Paths.Add({ TEXT("Step"),
+			[](double) { return FVector(1000.0, -500.0, 250.0); },
+			[](double) { return FRotator(-45.0, -150.0, 0.0); },
+			0.0, 0.0 });
+
+		// Línea recta a velocidad constante, girando a través de ±180
+		Paths.Add({ TEXT("Linear"),
+			[](double Time) { return FVector(600.0 * Time, -300.0 * Time, 0.0); },
+			[](double Time) { return FRotator(-45.0, 170.0 + 90.0 * Time, 0.0); },
+			FVector2D(600.0, 300.0).Size(), 90.0 });
+
+		// Círculo de 500 uu a 1.5 rad/s, con la cámara mirando al centro
+		Paths.Add({ TEXT("Circle"),
+			[](double Time) { return FVector(500.0 * FMath::Cos(1.5 * Time), 500.0 * FMath::Sin(1.5 * Time), 0.0); },
+			[](double Time) { return FRotator(-45.0, FMath::RadiansToDegrees(1.5 * Time) + 180.0, 0.0); },
+			500.0 * 1.5, FMath::RadiansToDegrees(1.5) });
+
+		return Paths;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraSpringFramerateTest, "RGBMask.Camera.Spring.FramerateIndependent",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraSpringFramerateTest::RunTest(const FString& Parameters)
+{
+	using namespace CameraSpringTests;
+
+	for (const FPawnPath& Path : MakePaths())
+	{
+		const TArray<FSample> Reference = Simulate(Path, ReferenceRate);
+
+		// Con objetivo constante la solución es exacta; si se mueve, cada frame lo ve fijo durante el paso,
+		// así que la diferencia con la referencia queda acotada por lo que avanza el pawn en un frame de 30 Hz
+		const double LocationTolerance = 0.01 + Path.Speed / SampleRate;
+		const double RotationTolerance = 0.01 + Path.AngularSpeed / SampleRate;
+
+		for (const int32 Rate : TestRates)
+		{
+			const TArray<FSample> Samples = Simulate(Path, Rate);
+			if (!TestEqual(FString::Printf(TEXT("%s: %d Hz sample count"), Path.Name, Rate), Samples.Num(), Reference.Num()))
+			{
+				continue;
+			}
+
+			double MaxLocationError = 0.0;
+			double MaxRotationError = 0.0;
+			for (int32 Index = 0; Index < Samples.Num(); ++Index)
+			{
+				MaxLocationError = FMath::Max(MaxLocationError, FVector::Dist(Samples[Index].Location, Reference[Index].Location));
+
+				const FRotator Delta = (Samples[Index].Rotation - Reference[Index].Rotation).GetNormalized();
+				MaxRotationError = FMath::Max(MaxRotationError, Delta.GetManhattanDistance(FRotator::ZeroRotator));
+			}
+
+			TestTrue(FString::Printf(TEXT("%s: %d Hz location matches %d Hz (max error %.4f, tolerance %.4f)"),
+				Path.Name, Rate, ReferenceRate, MaxLocationError, LocationTolerance), MaxLocationError <= LocationTolerance);
+			TestTrue(FString::Printf(TEXT("%s: %d Hz rotation matches %d Hz (max error %.4f, tolerance %.4f)"),
+				Path.Name, Rate, ReferenceRate, MaxRotationError, RotationTolerance), MaxRotationError <= RotationTolerance);
+
+			// Converge: asentado el muelle, el retraso respecto al pawn no pasa de 2v/Omega (régimen de un muelle crítico)
+			const FVector FinalTarget = Path.Location(Duration);
+			const double LagTolerance = 2.0 * Path.Speed / Omega + LocationTolerance + 1.0;
+			TestTrue(FString::Printf(TEXT("%s: %d Hz location converges"), Path.Name, Rate),
+				FVector::Dist(Samples.Last().Location, FinalTarget) <= LagTolerance);
+		}
+	}
+
+	// Omega 0 = sin suavizado: salta al objetivo en vez de congelarse
+	{
+		FVector Location(0.0, 0.0, 0.0);
+		FVector Velocity(100.0, 0.0, 0.0);
+		const FVector Target(1000.0, -500.0, 250.0);
+		CameraSpring::Step(Location, Velocity, Target, 0.0, 1.0 / 60.0);
+
+		TestTrue(TEXT("Omega 0 snaps to the target"), Location.Equals(Target));
+		TestTrue(TEXT("Omega 0 clears the velocity"), Velocity.IsZero());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,59 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "CursorFXPoolComponent.h"
+#include "NiagaraSystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCursorFXPoolRingTest, "RGBMask.CursorFX.Pool.NeverGrowsPastRingSize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCursorFXPoolRingTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 RingSize = 4;
+	constexpr int32 NumPlays = 256;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+	ON_SCOPE_EXIT { World->DestroyWorld(false); };
+
+	AActor* Owner = World->SpawnActor<AActor>();
+	if (!TestNotNull(TEXT("Owner"), Owner))
+	{
+		return false;
+	}
+
+	UCursorFXPoolComponent* Pool = NewObject<UCursorFXPoolComponent>(Owner);
+	Pool->RingSize = RingSize;
+	Pool->RegisterComponent();
+
+	// Positivo / negativo: cada sistema tiene su propio anillo
+	UNiagaraSystem* SystemA = NewObject<UNiagaraSystem>(GetTransientPackage());
+	UNiagaraSystem* SystemB = NewObject<UNiagaraSystem>(GetTransientPackage());
+
+	int32 MaxPooled = 0;
+	for (int32 PlayIndex = 0; PlayIndex < NumPlays; ++PlayIndex)
+	{
+		UNiagaraSystem* System = (PlayIndex % 3 == 0) ? SystemB : SystemA;
+		if (!TestTrue(FString::Printf(TEXT("PlayAt #%d"), PlayIndex), Pool->PlayAt(System, FVector(PlayIndex * 10.0, 0.0, 0.0))))
+		{
+			return false;
+		}
+
+		MaxPooled = FMath::Max(MaxPooled, Pool->GetNumPooledComponents());
+	}
+
+	TestTrue(FString::Printf(TEXT("Pool never grew past RingSize per system (max %d)"), MaxPooled), MaxPooled <= 2 * RingSize);
+	TestEqual(TEXT("Components created for two systems"), Pool->GetNumPooledComponents(), 2 * RingSize);
+	TestFalse(TEXT("PlayAt rejects a null system"), Pool->PlayAt(nullptr, FVector::ZeroVector));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,122 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "StrategyUnitSubsystem.h"
+#include "StrategyUnit.h"
+#include "StrategyPlayerController.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrategyUnitRegistryPerfTest, "RGBMask.Strategy.UnitRegistry.SelectionPerf",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FStrategyUnitRegistryPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumUnits = 2000;
+	constexpr int32 NumPasses = 10;
+	constexpr int32 UnitsPerRow = 50;
+	constexpr double UnitSpacing = 150.0;
+
+	// both native classes are abstract: spawn the variant's Blueprints, like the strategy level does
+	UClass* UnitClass = LoadClass<AStrategyUnit>(nullptr, TEXT("/Game/Variant_Strategy/Blueprints/BP_StrategyUnit.BP_StrategyUnit_C"));
+	UClass* ControllerClass = LoadClass<AStrategyPlayerController>(nullptr, TEXT("/Game/Variant_Strategy/Blueprints/BP_StrategyPlayerController.BP_StrategyPlayerController_C"));
+	if (!TestNotNull(TEXT("Unit class"), UnitClass) || !TestNotNull(TEXT("Controller class"), ControllerClass))
+	{
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+	ON_SCOPE_EXIT { World->DestroyWorld(false); };
+
+	UStrategyUnitSubsystem* UnitSubsystem = World->GetSubsystem<UStrategyUnitSubsystem>();
+	AStrategyPlayerController* Controller = World->SpawnActor<AStrategyPlayerController>(ControllerClass);
+	if (!TestNotNull(TEXT("Unit subsystem"), UnitSubsystem) || !TestNotNull(TEXT("Controller"), Controller))
+	{
+		return false;
+	}
+
+	// spread the units over many spatial hash cells. The world hasn't begun play, so we register them ourselves
+	TArray<AStrategyUnit*> Units;
+	Units.Reserve(NumUnits);
+
+	for (int32 i = 0; i < NumUnits; ++i)
+	{
+		const FVector Location((i % UnitsPerRow) * UnitSpacing, (i / UnitsPerRow) * UnitSpacing, 0.0);
+		if (AStrategyUnit* Unit = World->SpawnActor<AStrategyUnit>(UnitClass, Location, FRotator::ZeroRotator))
+		{
+			Units.Add(Unit);
+		}
+	}
+
+	if (!TestEqual(TEXT("Spawned units"), Units.Num(), NumUnits))
+	{
+		return false;
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+
+	for (AStrategyUnit* Unit : Units)
+	{
+		UnitSubsystem->RegisterUnit(Unit);
+	}
+
+	const double RegisterMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	TestEqual(TEXT("Registered units"), UnitSubsystem->GetNumUnits(), NumUnits);
+
+	// nothing renders in this world: flag every unit as rendered this frame so they all count as on screen
+	const float RenderTime = World->GetTimeSeconds();
+	for (AStrategyUnit* Unit : Units)
+	{
+		Unit->ForEachComponent<UPrimitiveComponent>(false, [RenderTime](UPrimitiveComponent* Primitive)
+		{
+			Primitive->SetLastRenderTime(RenderTime);
+		});
+	}
+
+	double SelectAllMs = 0.0;
+	double DeselectAllMs = 0.0;
+
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		StartTime = FPlatformTime::Seconds();
+
+		Controller->DoSelectAllOnScreenCommand();
+
+		SelectAllMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TestEqual(TEXT("Selected units after select all"), Controller->GetSelectedUnits().Num(), NumUnits);
+		TestTrue(TEXT("Unit is flagged after select all"), Controller->IsUnitSelected(Units[Pass]));
+
+		// selecting again must be rejected by the mask
+		TestFalse(TEXT("Reselecting a selected unit"), Controller->SelectUnit(Units[Pass]));
+
+		StartTime = FPlatformTime::Seconds();
+
+		Controller->DoDeselectAllCommand();
+
+		DeselectAllMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TestEqual(TEXT("Selected units after deselect all"), Controller->GetSelectedUnits().Num(), 0);
+		TestFalse(TEXT("Deselected unit is still flagged"), Controller->IsUnitSelected(Units[Pass]));
+	}
+
+	AddInfo(FString::Printf(TEXT("%d units: register %.3f ms, select all %.3f ms, deselect all %.3f ms (average of %d passes)"),
+		NumUnits, RegisterMs, SelectAllMs / NumPasses, DeselectAllMs / NumPasses, NumPasses));
+
+	for (AStrategyUnit* Unit : Units)
+	{
+		UnitSubsystem->UnregisterUnit(Unit);
+	}
+
+	TestEqual(TEXT("Registered units after unregistering"), UnitSubsystem->GetNumUnits(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
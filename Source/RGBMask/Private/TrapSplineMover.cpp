@@ -5,10 +5,13 @@
 #include "Components/BoxComponent.h"
 #include "CameraShakeSubsystem.h"
 #include "GameFramework/Character.h"
+#include "RGBMask.h"
 
 ATrapSplineMover::ATrapSplineMover()
 {
     PrimaryActorTick.bCanEverTick = true;
+    // Solo tickea mientras el timeline corre (ver StartTimeline)
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     Spline = CreateDefaultSubobject<USplineComponent>(TEXT("Spline"));
     RootComponent = Spline;
@@ -35,9 +38,8 @@ ATrapSplineMover::ATrapSplineMover()
 
 void ATrapSplineMover::ResetWallTrap()
 {
-    bActive = !bStartOnTrigger; 
+    bActive = false;
     Distance = InitialDistance;
-    DirectionSign = InitialDirectionSign;
 
     RestorePawnOnlyCollision();
 
@@ -53,6 +55,11 @@ void ATrapSplineMover::ResetWallTrap()
         StartTrigger->SetGenerateOverlapEvents(true);
     }
 
+    if (!bStartOnTrigger)
+    {
+        StartTimeline();
+    }
+
     if (Spline && TrapMesh)
     {
         const FVector Loc = Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
@@ -84,20 +91,70 @@ void ATrapSplineMover::BeginPlay()
     MeshShakeSeed = FMath::FRandRange(0.f, 1000.f);
 
     InitialDistance = StartDistance;
-    InitialDirectionSign = +1; 
 
     Distance = StartDistance;
-    DirectionSign = InitialDirectionSign;
     ResetWallTrap();
 
     if (bStartOnTrigger)
     {
         StartTrigger->OnComponentBeginOverlap.AddDynamic(this, &ATrapSplineMover::OnTriggerBeginOverlap);
     }
-    else
+}
+
+void ATrapSplineMover::StartTimeline()
+{
+    const double Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+
+    // Anclada al reloj del mundo, una trampa que entra por streaming aparece directamente
+    // donde le toca, en fase con el resto
+    TimelineStartTime = bSyncToWorldClock ? static_cast<double>(TimelineOffset) : Now;
+    Distance = EvaluateDistanceAtTime(Now);
+    bActive = true;
+
+    SetActorTickEnabled(true);
+}
+
+float ATrapSplineMover::EvaluateDistanceAtTime(double WorldTime) const
+{
+    const double SplineLen = Spline ? Spline->GetSplineLength() : 0.0;
+    if (SplineLen <= KINDA_SMALL_NUMBER) return 0.f;
+
+    const double Elapsed = FMath::Max(0.0, WorldTime - TimelineStartTime);
+    const double Travelled = FMath::Clamp(static_cast<double>(InitialDistance), 0.0, SplineLen) + Speed * Elapsed;
+
+    if (bReverseAtEnd)
+    {
+        // Ida y vuelta: onda triangular de periodo 2 * longitud
+        const double Phase = FMath::Fmod(Travelled, 2.0 * SplineLen);
+        return static_cast<float>(Phase <= SplineLen ? Phase : 2.0 * SplineLen - Phase);
+    }
+
+    if (bLoop)
     {
-        bActive = true;
+        return static_cast<float>(FMath::Fmod(Travelled, SplineLen));
     }
+
+    return static_cast<float>(FMath::Min(Travelled, SplineLen));
+}
+
+bool ATrapSplineMover::HasTimelineFinished(double WorldTime) const
+{
+    if (bReverseAtEnd || bLoop) return false;
+
+    const double SplineLen = Spline ? Spline->GetSplineLength() : 0.0;
+    const double Elapsed = FMath::Max(0.0, WorldTime - TimelineStartTime);
+    return InitialDistance + Speed * Elapsed >= SplineLen;
+}
+
+FTransform ATrapSplineMover::GetTrapTransformAtTime(double WorldTime) const
+{
+    if (!Spline) return GetActorTransform();
+
+    const float AtDistance = EvaluateDistanceAtTime(WorldTime);
+    return FTransform(
+        Spline->GetRotationAtDistanceAlongSpline(AtDistance, ESplineCoordinateSpace::World),
+        Spline->GetLocationAtDistanceAlongSpline(AtDistance, ESplineCoordinateSpace::World)
+    );
 }
 
 void ATrapSplineMover::RestorePawnOnlyCollision()
@@ -120,7 +177,7 @@ void ATrapSplineMover::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComp
 {
     if (Cast<ACharacter>(OtherActor))
     {
-        bActive = true;
+        StartTimeline();
 
         // desactivar trigger para que no re-dispare
         StartTrigger->SetGenerateOverlapEvents(false);
@@ -132,47 +189,22 @@ void ATrapSplineMover::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
 
-    if (!bActive || !Spline || !TrapMesh) return;
+    if (!bActive || !Spline || !TrapMesh)
+    {
+        // Trampa dormida: no hace falta tickear hasta el prximo StartTimeline
+        SetActorTickEnabled(false);
+        return;
+    }
 
-    const float SplineLen = Spline->GetSplineLength();
-    if (SplineLen <= KINDA_SMALL_NUMBER) return;
+    if (Spline->GetSplineLength() <= KINDA_SMALL_NUMBER) return;
 
-    Distance += DirectionSign * Speed * DeltaSeconds;
+    // Posicin en funcin del reloj, no integrada frame a frame
+    const double Now = GetWorld()->GetTimeSeconds();
+    Distance = EvaluateDistanceAtTime(Now);
 
-    // Manejo fin de spline
-    if (Distance >= SplineLen)
+    if (HasTimelineFinished(Now))
     {
-        if (bReverseAtEnd)
-        {
-            Distance = SplineLen;
-            DirectionSign = -1;
-        }
-        else if (bLoop)
-        {
-            Distance = 0.f;
-        }
-        else
-        {
-            Distance = SplineLen;
-            bActive = false;
-        }
-    }
-    else if (Distance <= 0.f)
-    {
-        if (bReverseAtEnd)
-        {
-            Distance = 0.f;
-            DirectionSign = +1;
-        }
-        else if (bLoop)
-        {
-            Distance = SplineLen;
-        }
-        else
-        {
-            Distance = 0.f;
-            bActive = false;
-        }
+        bActive = false;
     }
 
     SetTrapTransformAtDistance(Distance, DeltaSeconds);
@@ -204,7 +236,7 @@ void ATrapSplineMover::SetTrapTransformAtDistance(float InDistance, float DeltaS
             }
             ScheduleResetWallTrap(DefaultResetDelay);
  
-            UE_LOG(LogTemp, Warning, TEXT("Trampa golpe a %s"), *Char->GetName());
+            UE_LOG(LogRGBMaskTraps, VeryVerbose, TEXT("Trampa golpe a %s"), *Char->GetName());
         }
     }
 
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Muelle críticamente amortiguado integrado de forma analítica.
+ * La solución es exacta para un objetivo constante durante el paso, así que la curva no depende
+ * del framerate (30 Hz y 240 Hz recorren la misma trayectoria) y es estable con cualquier DeltaTime.
+ */
+namespace CameraSpring
+{
+	/**
+	 * Avanza Value/Velocity DeltaTime segundos hacia Target.
+	 * Omega es la frecuencia angular (1/s): mayor = llega antes. Tarda ~4/Omega en asentarse.
+	 * Omega <= 0 salta directamente al objetivo (como VInterpTo con velocidad 0).
+	 */
+	template <typename T>
+	FORCEINLINE void Step(T& Value, T& Velocity, const T& Target, double Omega, double DeltaTime)
+	{
+		if (DeltaTime <= 0.0)
+			return;
+
+		if (Omega <= 0.0)
+		{
+			Value = Target;
+			Velocity = Velocity * 0.0;
+			return;
+		}
+
+		// x(t) = (x0 + (v0 + w*x0) t) e^(-wt),  v(t) = (v0 - w (v0 + w*x0) t) e^(-wt)
+		const double Decay = FMath::Exp(-Omega * DeltaTime);
+		const T Offset = Value - Target;
+		const T Temp = (Velocity + Offset * Omega) * DeltaTime;
+
+		Velocity = (Velocity - Temp * Omega) * Decay;
+		Value = Target + (Offset + Temp) * Decay;
+	}
+
+	/** Igual que Step pero por ejes de rotación (grados), siempre por el camino angular más corto */
+	FORCEINLINE void StepRotator(FRotator& Value, FVector& AngularVelocity, const FRotator& Target, double Omega, double DeltaTime)
+	{
+		FVector Offset(
+			FRotator::NormalizeAxis(Value.Pitch - Target.Pitch),
+			FRotator::NormalizeAxis(Value.Yaw - Target.Yaw),
+			FRotator::NormalizeAxis(Value.Roll - Target.Roll));
+
+		Step(Offset, AngularVelocity, FVector::ZeroVector, Omega, DeltaTime);
+
+		Value = FRotator(Target.Pitch + Offset.X, Target.Yaw + Offset.Y, Target.Roll + Offset.Z).GetNormalized();
+	}
+}
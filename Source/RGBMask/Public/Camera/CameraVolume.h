@@ -7,6 +7,11 @@
 #include "GameFramework/Volume.h"
 #include "CameraVolume.generated.h"
 
+class ACameraVolume;
+class ULevelStreaming;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCameraVolumeBoundsChanged, ACameraVolume* /*Volume*/);
+
 UCLASS()
 class RGBMASK_API ACameraVolume : public AVolume
 {
@@ -19,32 +24,84 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
 	int32 Priority = 0; // posible mejora volumenes superpuestos
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera", meta = (ToolTip = "Margen adicional que permite a la cmara salirse del volumen"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera", meta = (ToolTip = "Margen adicional que permite a la cmara salirse del volumen. Si se cambia en runtime hay que llamar a RefreshCachedBounds"))
 	FVector CameraMargin = FVector(200.0f, 200.0f, 0.0f);
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera", meta = (ToolTip = "Si true, la prueba de punto usa la caja orientada del volumen (rotado) en vez de su AABB en mundo"))
+	bool bUseOrientedBounds = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera", meta = (ToolTip = "Actores que se ocultaran cuando este volumen este activo"))
 	TArray<AActor*> HiddenActors;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera|Streaming", meta = (ToolTip = "Subniveles que se piden cargar (sin bloquear) en cuanto el camera manager predice que el jugador va a entrar en este volumen"))
+	TArray<TSoftObjectPtr<UWorld>> PrefetchLevels;
+
 	void GetVolumeBounds(FVector& OutMin, FVector& OutMax) const;
 
 	bool IsLocationInsideVolume(const FVector& Location) const;
 
 	void GetCameraBounds(FVector& OutMin, FVector& OutMax) const;
 
+	/** AABB en mundo cacheada en BeginPlay (invlida antes de BeginPlay) */
+	const FBox& GetCachedBounds() const { return CachedBounds; }
+
+	/** Recalcula todos los lmites cacheados. Se llama solo al cambiar el transform del volumen */
+	void RefreshCachedBounds();
+
+	/** Se dispara tras recalcular los lmites por un cambio de transform */
+	FOnCameraVolumeBoundsChanged OnBoundsChanged;
+
+	/**
+	 * Pre-calienta la transicin hacia este volumen antes de cruzarlo: asegura los lmites cacheados,
+	 * resuelve la lista de actores a ocultar y pide cargar (sin hacer visibles) los PrefetchLevels.
+	 * Idempotente hasta que HideActors consume lo preparado o CancelTransition lo descarta.
+	 */
+	void PrepareTransition();
+
+	/** Descarta lo preparado si la prediccin cambia: suelta los niveles que carg PrepareTransition */
+	void CancelTransition();
+
+	/**
+	 * Activa el volumen: pide ocultar HiddenActors (se resuelve en lote al final del frame va
+	 * UActorVisibilitySubsystem) y mostrar los PrefetchLevels ya cargados
+	 */
 	void HideActors();
 
+	/** Libera las peticiones de HideActors: cada actor vuelve a lo que decidan las dems razones y se sueltan los PrefetchLevels */
 	void ShowActors();
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-	// Track which actors were originally hidden so we don't show them when switching volumes
-	TMap<AActor*, bool> OriginalVisibilityState;
+	// Actores para los que este volumen tiene una peticin de ocultar activa.
+	// Copia propia para que el refcount cuadre aunque HiddenActors cambie entre Hide y Show
+	TArray<TWeakObjectPtr<AActor>> RequestedHiddenActors;
+
+	// HiddenActors ya validados (y sin duplicados) por PrepareTransition, listos para HideActors
+	TSet<TWeakObjectPtr<AActor>> PreparedHiddenActors;
+	bool bTransitionPrepared = false;
+
+	// Niveles con peticin de carga de PrepareTransition (UCameraVolumeSubsystem), para soltarlos al cancelar
+	TArray<TWeakObjectPtr<ULevelStreaming>> PrefetchedStreamingLevels;
+
+	// Niveles con peticin visible mientras el volumen est activo (de HideActors a ShowActors)
+	TArray<TWeakObjectPtr<ULevelStreaming>> ActiveStreamingLevels;
+
+	// Entre HideActors y ShowActors (aunque no haya HiddenActors)
+	bool bIsActive = false;
+
+	// GetActorBounds recorre los componentes: lo hacemos una vez y reutilizamos
+	FBox CachedBounds = FBox(ForceInit);
+	FBox CachedCameraBounds = FBox(ForceInit);
+
+	// Caja en espacio local + inversa precalculada para la prueba orientada
+	FBox LocalBounds = FBox(ForceInit);
+	FMatrix WorldToLocal = FMatrix::Identity;
+
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 
 };
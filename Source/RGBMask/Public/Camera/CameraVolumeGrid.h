@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACameraVolume;
+
+/**
+ * Rejilla uniforme 2D (plano XY) de volúmenes de cámara.
+ * Cada celda guarda los volúmenes cuyos límites la solapan, ordenados por prioridad
+ * (mayor primero), así que buscar el volumen activo solo prueba los candidatos de la
+ * celda del jugador en vez de todos los volúmenes del nivel.
+ */
+struct RGBMASK_API FCameraVolumeGrid
+{
+public:
+	explicit FCameraVolumeGrid(float InCellSize = 2000.0f);
+
+	/** Cambia el tamaño de celda. Vacía la rejilla: hay que volver a añadir los volúmenes. */
+	void SetCellSize(float InCellSize);
+
+	float GetCellSize() const { return CellSize; }
+
+	/** Inserta el volumen en todas las celdas que solapan sus límites cacheados */
+	void Add(ACameraVolume* Volume);
+
+	/** Quita el volumen de las celdas donde se insertó */
+	void Remove(const ACameraVolume* Volume);
+
+	void Reset();
+
+	FIntPoint GetCellCoord(const FVector& Location) const;
+
+	/** Candidatos de una celda ordenados por prioridad, o nullptr si la celda está vacía */
+	const TArray<TWeakObjectPtr<ACameraVolume>>* FindCell(const FIntPoint& Cell) const;
+
+	/** Se incrementa con cada Add/Remove/Reset; sirve para invalidar punteros cacheados a celdas */
+	uint32 GetRevision() const { return Revision; }
+
+private:
+	FIntRect GetCellRange(const FBox& Bounds) const;
+
+	float CellSize;
+	uint32 Revision = 0;
+
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ACameraVolume>>> Cells;
+
+	// Rango de celdas de cada volumen en el momento de insertarlo (solo identidad, no se desreferencia)
+	TMap<const ACameraVolume*, FIntRect> VolumeCellRanges;
+};
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Camera/CameraVolumeGrid.h"
+#include "CameraVolumeSubsystem.generated.h"
+
+class ACameraVolume;
+class ULevelStreaming;
+
+/**
+ * Registro de volúmenes de cámara del mundo.
+ * Los volúmenes se registran solos en BeginPlay/EndPlay, así que la lista ordenada por
+ * prioridad y la rejilla espacial se mantienen al día con el streaming de subniveles
+ * sin tener que recorrer todos los actores.
+ */
+UCLASS()
+class RGBMASK_API UCameraVolumeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void Register(ACameraVolume* Volume);
+	void Unregister(ACameraVolume* Volume);
+
+	/** Volúmenes registrados, ordenados por prioridad (mayor primero) */
+	const TArray<TWeakObjectPtr<ACameraVolume>>& GetVolumes() const { return Volumes; }
+
+	/** Volumen de mayor prioridad, usado cuando el jugador no está dentro de ninguno */
+	ACameraVolume* GetHighestPriorityVolume() const;
+
+	const FCameraVolumeGrid& GetGrid() const { return Grid; }
+
+	/** Cambia el tamaño de celda y reindexa todos los volúmenes (no hace nada si no cambia) */
+	void SetGridCellSize(float CellSize);
+
+	/**
+	 * Pide cargar (y si bVisible, mostrar) un subnivel en nombre de un volumen.
+	 * Con refcount por nivel: varios volúmenes pueden listar el mismo subnivel y solo se
+	 * descarga/oculta cuando ninguno lo pide. Una petición visible cuenta también como de carga.
+	 */
+	void RequestLevelStreaming(ULevelStreaming* Level, bool bVisible);
+
+	/** Suelta una petición de RequestLevelStreaming hecha con el mismo bVisible */
+	void ReleaseLevelStreaming(ULevelStreaming* Level, bool bVisible);
+
+private:
+	void OnVolumeBoundsChanged(ACameraVolume* Volume);
+
+	struct FLevelStreamingRequest
+	{
+		TWeakObjectPtr<ULevelStreaming> Level;
+		int32 LoadCount = 0;
+		int32 VisibleCount = 0;
+
+		// Estado antes de la primera petición: si ya lo tenía pedido otro (streaming volume,
+		// blueprint...) no lo descargamos/ocultamos al soltar
+		bool bWasLoaded = false;
+		bool bWasVisible = false;
+	};
+
+	void ApplyLevelStreaming(const FLevelStreamingRequest& Request) const;
+
+	// Pocos subniveles a la vez: búsqueda lineal
+	TArray<FLevelStreamingRequest> LevelRequests;
+
+	TArray<TWeakObjectPtr<ACameraVolume>> Volumes;
+
+	FCameraVolumeGrid Grid;
+};
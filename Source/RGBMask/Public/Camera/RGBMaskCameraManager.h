@@ -7,6 +7,9 @@
 #include "CameraVolume.h"
 #include "RGBMaskCameraManager.generated.h"
 
+class APawn;
+class UCameraVolumeSubsystem;
+
 /**
  * 
  */
@@ -28,7 +31,10 @@ protected:
     ACameraVolume* PreviousCameraVolume;
 
     UPROPERTY()
-    TArray<ACameraVolume*> CameraVolumes;
+    UCameraVolumeSubsystem* VolumeSubsystem;
+
+    // ltimo volumen preparado por prediccin (para no repetir el trabajo cada frame)
+    TWeakObjectPtr<ACameraVolume> PrefetchedCameraVolume;
 
     // Camera offset settings
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Offset", meta = (ToolTip = "Distancia hacia atrs desde el jugador"))
@@ -45,33 +51,57 @@ protected:
 
 
     // Transition settings
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Transition", meta = (ToolTip = "Velocidad de interpolacin de la cmara entre volmenes"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Transition", meta = (ClampMin = "0.0", UIMin = "0.5", ToolTip = "Rigidez (1/s) del muelle de la cmara entre volmenes. Se asienta en ~4/valor segundos. 0 = sin suavizado (salta al objetivo)"))
     float CameraTransitionSpeed = 5.0f; // Ajusta segn necesites (ms alto = ms rpido)
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Transition", meta = (ToolTip = "Si true, interpola tambin la rotacin de la cmara"))
     bool bInterpolateRotation = true;
 
-    // Buscar volmenes en el nivel
-    void FindCameraVolumes();
+    // Transition prefetch
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Transition", meta = (ToolTip = "Si true, predice el prximo volumen con la velocidad del jugador y prepara la transicin antes de cruzar"))
+    bool bPrefetchVolumeTransitions = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Transition", meta = (EditCondition = "bPrefetchVolumeTransitions", ClampMin = "0.0", ToolTip = "Segundos de anticipacin con los que se predice el cruce de volumen"))
+    float TransitionPrefetchLookahead = 0.5f;
+
+    // Spatial index
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Volumes", meta = (ClampMin = "100.0", ToolTip = "Tamao de celda (cm) de la rejilla de volmenes. Solo se reconsulta la rejilla al cambiar de celda"))
+    float VolumeGridCellSize = 2000.0f;
+
+    // Enlazar con el subsistema donde se registran los volmenes
+    void InitializeVolumeSubsystem();
 
     // Determinar qu volumen usar basado en la posicin del jugador
     ACameraVolume* GetActiveVolume(const FVector& PlayerLocation);
 
+    // Predecir el siguiente volumen y preparar la transicin con antelacin
+    void PrefetchNextVolume(const APawn& PlayerPawn, const FVector& PlayerLocation);
+
+    /** Volumen (distinto del activo) en el que estar el jugador dentro de TransitionPrefetchLookahead, o nullptr */
+    ACameraVolume* PredictNextVolume(const APawn& PlayerPawn, const FVector& PlayerLocation) const;
+
     // Aplicar el clamp a la cmara
     void ClampCameraToVolume(FVector& CameraLocation);
 
-    void ApplyCameraOffset(FTViewTarget& OutVT, const FVector& PlayerLocation);
+    // Pose objetivo (offset + mirada al jugador) calculada directamente desde el pawn
+    void ComputeCameraOffsetPose(const APawn& PlayerPawn, const FVector& PlayerLocation, FVector& OutLocation, FRotator& OutRotation) const;
 
     // Manejar el cambio de volumen activo
     void HandleVolumeChange(ACameraVolume* NewVolume);
-
 private:
     bool bVolumesInitialized = false;
 
+    // Candidatos de la ltima celda consultada; vlidos mientras no cambie la revisin de la rejilla
+    const TArray<TWeakObjectPtr<ACameraVolume>>* CachedCellVolumes = nullptr;
+    FIntPoint CachedCell = FIntPoint(MAX_int32, MAX_int32);
+    uint32 CachedGridRevision = 0;
+
     // Transition state
     bool bIsTransitioning = false;
     FVector CurrentCameraLocation; 
     FRotator CurrentCameraRotation;
+    FVector CameraVelocity;
+    FVector CameraAngularVelocity; // grados/s por eje (Pitch, Yaw, Roll)
     FVector TransitionStartLocation;
     FRotator TransitionStartRotation;
     FVector TransitionTargetLocation;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CameraShakeCatalog.generated.h"
+
+class UCameraShakeBase;
+
+/** How several requests of the same profile in one frame are folded into a single shake */
+UENUM(BlueprintType)
+enum class ECameraShakeMergeMode : uint8
+{
+    /** Strongest request wins (impacts, hits) */
+    Max UMETA(DisplayName = "Max"),
+    /** Requests add up to MaxMergedScale (AoE hitting many targets) */
+    Sum UMETA(DisplayName = "Sum (capped)")
+};
+
+/**
+ * One named camera shake + rumble preset. Gameplay code refers to it by Tag
+ * (resolved once to a profile id through UCameraShakeSubsystem::FindProfileId).
+ */
+USTRUCT(BlueprintType)
+struct RGBMASK_API FCameraShakeProfile
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake", meta = (ToolTip = "Unique name used to look up this profile (e.g. Trap.Impact, AoE, Projectile.Hit, Mask.Switch)."))
+    FName Tag;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake")
+    TSubclassOf<UCameraShakeBase> ShakeClass;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake", meta = (ToolTip = "Base intensity multiplier. 1.0 = normal."))
+    float DefaultScale = 10.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake", meta = (ClampMin = "0.0"))
+    float MinScale = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake", meta = (ClampMin = "0.0"))
+    float MaxScale = 20.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Merge", meta = (ToolTip = "How requests of this profile made in the same frame are combined."))
+    ECameraShakeMergeMode MergeMode = ECameraShakeMergeMode::Max;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Merge", meta = (ClampMin = "0.0", ToolTip = "Cap for the combined scale in Sum mode (before the Min/MaxScale clamp)."))
+    float MaxMergedScale = 20.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Merge", meta = (ToolTip = "When more profiles are requested in a frame than the subsystem plays, higher priority wins (then higher scale)."))
+    int32 Priority = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Falloff", meta = (ClampMin = "0.0", ToolTip = "Inner radius (cm). At or below this distance, intensity is 100%."))
+    float InnerRadius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Falloff", meta = (ClampMin = "0.0", ToolTip = "Outer radius (cm). At or above this distance, intensity is 0. If Outer<=Inner, falloff is disabled."))
+    float OuterRadius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Rumble")
+    bool bPlayRumble = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Rumble", meta = (EditCondition = "bPlayRumble", ClampMin = "0.0", ClampMax = "1.0"))
+    float RumbleIntensity = 0.7f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Rumble", meta = (EditCondition = "bPlayRumble", ClampMin = "0.0"))
+    float RumbleDuration = 0.40f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Rumble", meta = (EditCondition = "bPlayRumble", ClampMin = "0.0", ClampMax = "1.0"))
+    float MinRumble = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Rumble", meta = (EditCondition = "bPlayRumble", ClampMin = "0.0", ClampMax = "1.0"))
+    float MaxRumble = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Cooldown", meta = (ClampMin = "0.0", ToolTip = "Minimum time (seconds) between two plays of this profile. 0 = no cooldown."))
+    float CooldownSeconds = 0.12f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake|Cooldown", meta = (ToolTip = "If true, the cooldown is tracked per source object (each trap has its own); otherwise it is shared by every caller of this profile."))
+    bool bCooldownPerSource = false;
+};
+
+/**
+ * Data asset listing every camera shake profile the game can request.
+ * Assigned to UCameraShakeSubsystem through config (CatalogAsset) or at runtime with SetCatalog.
+ */
+UCLASS(BlueprintType)
+class RGBMASK_API UCameraShakeCatalog : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Shake", meta = (TitleProperty = "Tag"))
+    TArray<FCameraShakeProfile> Profiles;
+
+#if WITH_EDITOR
+    virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+};
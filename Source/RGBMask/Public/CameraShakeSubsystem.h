@@ -2,27 +2,79 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "CameraShakeCatalog.h"
 #include "CameraShakeSubsystem.generated.h"
 
 class UCameraShakeBase;
-
-UCLASS()
-class RGBMASK_API UCameraShakeSubsystem : public UWorldSubsystem
+class APlayerController;
+
+/**
+ * Camera shake + rumble requests for every local player (split-screen / local co-op).
+ * Requests are queued during the frame and resolved once in Tick: each local camera is evaluated
+ * against the request sources, requests of the same profile are merged (max or capped sum),
+ * at most MaxShakesPerFrame shakes are started and rumble is updated once per player.
+ */
+UCLASS(Config = Game)
+class RGBMASK_API UCameraShakeSubsystem : public UTickableWorldSubsystem
 {
     GENERATED_BODY()
 
 public:
     UCameraShakeSubsystem();
 
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Resolve the queued requests now instead of waiting for the end-of-frame pass */
+    void Flush();
+
+    /** Id of the built-in profile (DefaultImpactShake with the legacy PlayShake defaults). Always valid. */
+    static constexpr int32 DefaultProfileId = 0;
+
     /**
-     * Plays a global camera shake (PlayerController 0 by default).
+     * Replaces the active shake catalog and rebuilds the profile table.
+     * Profile ids resolved before this call are no longer valid.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera|Shake")
+    void SetCatalog(UCameraShakeCatalog* NewCatalog);
+
+    /**
+     * Resolves a profile tag to its id (INDEX_NONE if the tag is unknown).
+     * Ids are stable until SetCatalog, so callers should resolve once (e.g. in BeginPlay) and keep the id.
+     */
+    UFUNCTION(BlueprintPure, Category = "Camera|Shake")
+    int32 FindProfileId(FName Tag) const;
+
+    /**
+     * Queues a catalog profile for this frame. Falloff, merging, rumble and cooldown are applied when the queue is resolved.
+     *
+     * @param ProfileId        Id returned by FindProfileId.
+     * @param WorldSource      World-space event origin. Used only if the profile has distance falloff.
+     * @param ScaleMultiplier  Multiplies the profile DefaultScale (before clamping).
+     * @param Source           Object that caused the shake. Only used by profiles with a per-source cooldown.
+     * @return true if the request was queued (false if the profile is invalid or still on cooldown).
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera|Shake")
+    bool PlayShakeProfile(int32 ProfileId, FVector WorldSource = FVector::ZeroVector, float ScaleMultiplier = 1.0f, const UObject* Source = nullptr);
+
+    /** Convenience wrapper: FindProfileId + PlayShakeProfile. Unknown tags fall back to the default profile. */
+    UFUNCTION(BlueprintCallable, Category = "Camera|Shake")
+    bool PlayShakeByTag(FName Tag, FVector WorldSource = FVector::ZeroVector, float ScaleMultiplier = 1.0f, const UObject* Source = nullptr);
+
+    /**
+     * Plays a camera shake on every local player.
      *
      * If distance falloff is enabled (OuterRadius > InnerRadius and WorldSource is not ZeroVector),
-     * the final intensity is scaled based on the camera distance to WorldSource:
+     * the final intensity is scaled per player based on that player's camera distance to WorldSource:
      * - distance <= InnerRadius  => 100% intensity
      * - distance >= OuterRadius  => 0% intensity
      * - between                 => linearly interpolated
      *
+     * Uses DefaultImpactShake and shares the cooldown of the default profile.
+     * Prefer PlayShakeProfile for new code.
+     *
      * @param Scale            Base intensity multiplier (1.0 = normal).
      * @param CooldownSeconds  Minimum time (seconds) between playing the SAME shake to prevent spam (0 = no cooldown).
      * @param WorldSource      World-space event origin (explosion/impact location). Used only for distance falloff.
@@ -63,7 +115,91 @@ public:
 
 
 private:
+    /** Catalog loaded on Initialize. Set in DefaultGame.ini under [/Script/RGBMask.CameraShakeSubsystem] */
+    UPROPERTY(Config)
+    TSoftObjectPtr<UCameraShakeCatalog> CatalogAsset;
+
+    UPROPERTY()
+    TObjectPtr<UCameraShakeCatalog> Catalog;
+
     UPROPERTY(EditDefaultsOnly, Category = "Camera|Shake")
     TSubclassOf<UCameraShakeBase> DefaultImpactShake;
-    TMap<TSubclassOf<UCameraShakeBase>, double> LastPlayTimeByShake;
+
+    // Perfiles activos indexados por id: [DefaultProfileId] = DefaultImpactShake, luego los del catálogo
+    TArray<FCameraShakeProfile> Profiles;
+    TMap<FName, int32> ProfileIdByTag;
+
+    struct FSourceCooldown
+    {
+        TWeakObjectPtr<const UObject> Source;
+        double LastPlayTime = 0.0;
+    };
+
+    struct FProfileCooldown
+    {
+        double LastPlayTime = -DBL_MAX;
+        TArray<FSourceCooldown> BySource; // solo perfiles con bCooldownPerSource (pocas fuentes vivas a la vez)
+    };
+
+    // Paralelo a Profiles: el cooldown de cada perfil es independiente
+    TArray<FProfileCooldown> Cooldowns;
+
+    /** Max camera shakes started per frame (one per profile, highest priority first) */
+    UPROPERTY(Config, EditDefaultsOnly, Category = "Camera|Shake", meta = (ClampMin = "1"))
+    int32 MaxShakesPerFrame = 2;
+
+    struct FPendingShake
+    {
+        int32 ProfileId = INDEX_NONE;
+        int32 OverrideIndex = INDEX_NONE; // PlayShake legacy: parámetros propios en PendingOverrides
+        float Scale = 0.f;
+        FVector WorldSource = FVector::ZeroVector;
+        TWeakObjectPtr<const UObject> Source;
+    };
+
+    // Resultado de fusionar todas las peticiones de un perfil en el frame
+    struct FShakeBucket
+    {
+        const FCameraShakeProfile* Profile = nullptr;
+        float Scale = 0.f;
+        float CooldownSeconds = 0.f;
+        bool bActive = false;
+
+        // Lanzado este frame para algún jugador: solo entonces cuenta el cooldown por fuente
+        bool bPlayed = false;
+    };
+
+    TArray<FPendingShake> PendingShakes;
+    TArray<FCameraShakeProfile> PendingOverrides;
+
+    // Paralelo a Profiles, reutilizado cada frame
+    TArray<FShakeBucket> Buckets;
+    TArray<int32> ActiveBuckets;
+
+    struct FLocalView
+    {
+        TWeakObjectPtr<APlayerController> PlayerController;
+        FVector CameraLocation = FVector::ZeroVector;
+    };
+
+    // Cámaras locales de este frame (se rellena una vez en Flush)
+    TArray<FLocalView> LocalViews;
+
+    void CacheLocalViews();
+
+    /** Merge + prioritize + start shakes and rumble for one local player. Returns the number of shakes started */
+    int32 ResolveForView(APlayerController& PC, const FVector& CamLoc, double Now);
+
+    const FCameraShakeProfile& GetRequestProfile(const FPendingShake& Request) const;
+
+    void RebuildProfiles();
+
+    bool IsOnCooldown(int32 ProfileId, float CooldownSeconds, const UObject* Source, double Now);
+    void MarkPlayed(int32 ProfileId, const UObject* Source, double Now);
+
+    /** True if one of the first NumAccepted pending requests already comes from Source for this profile */
+    bool IsSourceAccepted(int32 ProfileId, const UObject* Source, int32 NumAccepted) const;
+
+    /** 1 inside InnerRadius, 0 beyond OuterRadius (or 1 if the profile has no falloff) */
+    static float ComputeFalloff(const FCameraShakeProfile& Profile, const FVector& WorldSource, const FVector& CameraLocation);
 };
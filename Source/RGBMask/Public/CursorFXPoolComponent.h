@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CursorFXPoolComponent.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+
+/**
+ * Small ring of reusable Niagara components for cursor feedback.
+ * Each system gets up to RingSize components; once they exist, a new play restarts the oldest one,
+ * so rapid clicking never allocates a component.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class RGBMASK_API UCursorFXPoolComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCursorFXPoolComponent();
+
+	// Config
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pool", meta = (ClampMin = "1"))
+	int32 RingSize = 4;
+
+	/** Plays System at Location reusing a pooled component. Returns false if System is null */
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+	bool PlayAt(UNiagaraSystem* System, FVector Location);
+
+	/** Creates the whole ring for System up front (optional: otherwise it fills on the first plays) */
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+	void Prewarm(UNiagaraSystem* System);
+
+	/** Components created by this pool so far, across all systems (never more than RingSize per system) */
+	int32 GetNumPooledComponents() const { return AllComponents.Num(); }
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FFXRing
+	{
+		TObjectPtr<UNiagaraSystem> System;
+		TArray<TObjectPtr<UNiagaraComponent>> Components;
+		int32 Next = 0;
+	};
+
+	// Normalmente 1-2 sistemas (positivo / negativo): búsqueda lineal
+	TArray<FFXRing> Rings;
+
+	// Referencias GC de los componentes de todos los anillos
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraComponent>> AllComponents;
+
+	FFXRing& FindOrAddRing(UNiagaraSystem* System);
+	UNiagaraComponent* CreateComponent(UNiagaraSystem* System);
+};
@@ -23,6 +23,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Reset")
     void ScheduleResetWallTrap(float DelaySeconds);
 
+    /**
+     * Distancia sobre el spline en el instante WorldTime (mismo reloj que UWorld::GetTimeSeconds).
+     * Forma cerrada: no depende del historial de frames, as que es O(1) para cualquier instante.
+     */
+    UFUNCTION(BlueprintPure, Category = "Timeline")
+    float EvaluateDistanceAtTime(double WorldTime) const;
+
+    /** Pose del mesh (sin vibracin) en el instante WorldTime. */
+    UFUNCTION(BlueprintPure, Category = "Timeline")
+    FTransform GetTrapTransformAtTime(double WorldTime) const;
+
 protected:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaSeconds) override;
@@ -51,6 +62,13 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Stats", meta = (ClampMin = "0.0"))
     float StartDistance = 0.f;
 
+    /** Si true, la fase se ancla al reloj del mundo (t = TimelineOffset) en vez de al BeginPlay/reset: trampas con el mismo offset van siempre sincronizadas. */
+    UPROPERTY(EditAnywhere, Category = "Stats|Timeline", meta = (EditCondition = "!bStartOnTrigger"))
+    bool bSyncToWorldClock = false;
+
+    UPROPERTY(EditAnywhere, Category = "Stats|Timeline", meta = (EditCondition = "bSyncToWorldClock && !bStartOnTrigger"))
+    float TimelineOffset = 0.f;
+
     UPROPERTY(EditAnywhere, Category = "Stats|Collision", DisplayName = "Sweep (solo Pawn)")
     bool bSweepCollision = true;
 
@@ -66,14 +84,18 @@ protected:
 private:
 
     float InitialDistance = 0.f;
-    int32 InitialDirectionSign = +1;
 
     FTimerHandle ResetTimerHandle;
 
     void RestorePawnOnlyCollision();
     bool bActive = false;
     float Distance = 0.f;
-    int32 DirectionSign = +1;
+
+    // Instante (reloj del mundo) en el que la trampa estaba en InitialDistance
+    double TimelineStartTime = 0.0;
+
+    void StartTimeline();
+    bool HasTimelineFinished(double WorldTime) const;
 
     bool bHasDisabledMeshCollision = false;
 
@@ -2,8 +2,36 @@
 
 #include "RGBMask.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/IConsoleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, RGBMask, "RGBMask" );
 
 DEFINE_LOG_CATEGORY(LogRGBMask)
- 
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogRGBMaskCamera)
+DEFINE_LOG_CATEGORY(LogRGBMaskMasks)
+DEFINE_LOG_CATEGORY(LogRGBMaskPostProcess)
+DEFINE_LOG_CATEGORY(LogRGBMaskTraps)
+
+#if !NO_LOGGING
+namespace RGBMaskLog
+{
+	static int32 GHotPathLogs = 0;
+
+	static void OnHotPathLogsChanged(IConsoleVariable* Var)
+	{
+		const ELogVerbosity::Type Verbosity = GHotPathLogs > 0 ? ELogVerbosity::VeryVerbose : ELogVerbosity::Log;
+
+		LogRGBMaskCamera.SetVerbosity(Verbosity);
+		LogRGBMaskMasks.SetVerbosity(Verbosity);
+		LogRGBMaskPostProcess.SetVerbosity(Verbosity);
+		LogRGBMaskTraps.SetVerbosity(Verbosity);
+	}
+
+	static FAutoConsoleVariableRef CVarHotPathLogs(
+		TEXT("rgbmask.HotPathLogs"),
+		GHotPathLogs,
+		TEXT("1 enables VeryVerbose hot-path logging for the camera, mask, post-process and trap categories. 0 restores Log."),
+		FConsoleVariableDelegate::CreateStatic(&OnHotPathLogsChanged),
+		ECVF_Cheat);
+}
+#endif
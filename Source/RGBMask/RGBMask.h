@@ -6,3 +6,19 @@
 
 /** Main log category used across the project */
 DECLARE_LOG_CATEGORY_EXTERN(LogRGBMask, Log, All);
+
+/**
+ * Per-subsystem categories. Hot-path messages (per frame, per actor, per mask switch) are logged at
+ * VeryVerbose and compiled out of Test/Shipping builds; in other builds they are off by default and
+ * can be turned on at runtime with rgbmask.HotPathLogs 1 (or "log <Category> VeryVerbose").
+ */
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+	#define RGBMASK_HOTPATH_LOG_COMPILE_VERBOSITY Log
+#else
+	#define RGBMASK_HOTPATH_LOG_COMPILE_VERBOSITY All
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogRGBMaskCamera, Log, RGBMASK_HOTPATH_LOG_COMPILE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogRGBMaskMasks, Log, RGBMASK_HOTPATH_LOG_COMPILE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogRGBMaskPostProcess, Log, RGBMASK_HOTPATH_LOG_COMPILE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogRGBMaskTraps, Log, RGBMASK_HOTPATH_LOG_COMPILE_VERBOSITY);
@@ -12,8 +12,12 @@
 #include "Engine/World.h"
 #include "Engine/PostProcessVolume.h"
 #include "Materials/MaterialInstance.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "TimerManager.h"
-#include "Kismet/GameplayStatics.h"
+#include "MaskPostProcessSubsystem.h"
+#include "MaskSwitchStats.h"
+#include "Misc/ScopeExit.h"
+#include "RGBMask.h"
 
 
 ARGBMaskCharacter::ARGBMaskCharacter()
@@ -50,16 +54,16 @@ ARGBMaskCharacter::ARGBMaskCharacter()
 	// Activate ticking in order to update the cursor every frame.
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
-	Masks.Reserve(3);
-
-	Masks.Add(EMaskType::Blue, false);
-	Masks.Add(EMaskType::Red, false);
-	Masks.Add(EMaskType::Green, false);
+	for (int32& Index : PostProcessBlendableIndices)
+	{
+		Index = INDEX_NONE;
+	}
 }
 
 void ARGBMaskCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+	BuildMaskLookupTables();
 	OnMaskChanged.Broadcast(CurrentMask);
 	if (USkeletalMeshComponent* MeshComp = GetMesh())
 	{
@@ -68,71 +72,50 @@ void ARGBMaskCharacter::BeginPlay()
 
 		const int32 SafeIndex = FMath::Clamp(MaskMaterialIndex, 0, NumMats - 1);
 		MainMaterial = MeshComp->GetMaterial(SafeIndex);
+		MaskMeshMaterials[GetMaskIndex(EMaskType::None)] = MainMaterial;
 	}
 
-	// PostProcessVolume setup
-	UE_LOG(LogTemp, Warning, TEXT("========== INITIALIZING POST-PROCESS SYSTEM =========="));
-
+	// PostProcessVolume setup: the world subsystem resolves it once, respawns just read the cache
 	if (!PostProcessVolume && bUsePostProcessEffects)
 	{
-		UE_LOG(LogTemp, Log, TEXT("PostProcessVolume not assigned, attempting auto-detection..."));
-
-		if (UWorld* World = GetWorld())
+		if (UMaskPostProcessSubsystem* PostProcessSub = GetWorld() ? GetWorld()->GetSubsystem<UMaskPostProcessSubsystem>() : nullptr)
 		{
-			TArray<AActor*> FoundActors;
-			UGameplayStatics::GetAllActorsOfClass(World, APostProcessVolume::StaticClass(), FoundActors);
-
-			UE_LOG(LogTemp, Log, TEXT("Found %d PostProcessVolume(s) in the level"), FoundActors.Num());
-
-			for (AActor* Actor : FoundActors)
-			{
-				APostProcessVolume* PPV = Cast<APostProcessVolume>(Actor);
-				if (PPV && PPV->bUnbound)
-				{
-					PostProcessVolume = PPV;
-					UE_LOG(LogTemp, Warning, TEXT("✓ Auto-detected UNBOUND PostProcessVolume: %s"), *PPV->GetName());
-					break;
-				}
-			}
-
-			if (!PostProcessVolume && FoundActors.Num() > 0)
-			{
-				PostProcessVolume = Cast<APostProcessVolume>(FoundActors[0]);
-				UE_LOG(LogTemp, Warning, TEXT("⚠ Using first PostProcessVolume (NOT unbound): %s"),
-					*PostProcessVolume->GetName());
-				UE_LOG(LogTemp, Warning, TEXT("  Consider setting bUnbound=true on this volume for global effect"));
-			}
-
-			if (!PostProcessVolume)
-			{
-				UE_LOG(LogTemp, Error, TEXT("✗ No PostProcessVolume found in level! Post-process effects will not work."));
-				UE_LOG(LogTemp, Error, TEXT("  Please add a PostProcessVolume to your level and set bUnbound=true"));
-			}
+			PostProcessVolume = PostProcessSub->GetMaskPostProcessVolume();
 		}
 	}
 	else if (PostProcessVolume)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("✓ Using manually assigned PostProcessVolume: %s"), *PostProcessVolume->GetName());
+		UE_LOG(LogRGBMaskPostProcess, Verbose, TEXT("Using manually assigned PostProcessVolume: %s"), *PostProcessVolume->GetName());
 	}
-	else
-	{
-		UE_LOG(LogTemp, Log, TEXT("Post-process effects disabled (bUsePostProcessEffects = false)"));
-	}
-
-	UE_LOG(LogTemp, Warning, TEXT("======================================================"));
 
 	// Apply initial post process effect
 	UpdatePostProcess();
+}
+
+void ARGBMaskCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The volume outlives the character: don't leave our passes (or our MID) in it across respawns
+	UnregisterPostProcessBlendables();
+
+	// A pending switch dies with us: close its timing record so the next character starts clean
+	if (bIsMaskChangeInProgress)
+	{
+		GetWorldTimerManager().ClearTimer(MaskChangeTimerHandle);
+		bIsMaskChangeInProgress = false;
+		MaskSwitchStats::AbortSwitch();
+	}
 
-	// Print debug info
-	DebugPrintPostProcessInfo();
+	Super::EndPlay(EndPlayReason);
 }
 
 void ARGBMaskCharacter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	// stub
+	if (bIsBlendingPostProcess)
+	{
+		TickPostProcessBlend(DeltaSeconds);
+	}
 }
 
 //void ARGBMaskCharacter::SetMask(EMaskType NewMask)
@@ -171,7 +154,7 @@ void ARGBMaskCharacter::Tick(float DeltaSeconds)
 //
 //}
 
-void ARGBMaskCharacter::SetMask(EMaskType NewMask)
+void ARGBMaskCharacter::SetMask(EMaskType NewMask, double InputTime)
 {
 	// Si ya estamos en el proceso de cambiar a esta m�scara, no hacemos nada
 	if (bIsMaskChangeInProgress && PendingMask == NewMask) return;
@@ -187,8 +170,15 @@ void ARGBMaskCharacter::SetMask(EMaskType NewMask)
 			World->GetTimerManager().ClearTimer(MaskChangeTimerHandle);
 		}
 		bIsMaskChangeInProgress = false;
+
+		// The superseded switch never gets applied: don't let it time the new one
+		MaskSwitchStats::AbortSwitch();
 	}
 
+	// Only switches that really happen open a timing record
+	MaskSwitchStats::BeginSwitch(NewMask, InputTime);
+	RGBMASK_MASK_SWITCH_SCOPE(SetMask);
+
 	// Guardar la m�scara pendiente
 	PendingMask = NewMask;
 	bIsMaskChangeInProgress = true;
@@ -223,31 +213,19 @@ void ARGBMaskCharacter::SetMask(EMaskType NewMask)
 
 void ARGBMaskCharacter::ApplyMaskChange()
 {
+	// Stamps the switch as applied on every exit path. The record itself is pushed when the outermost
+	// stage scope (Toggle / SetMask with no delay, this one from the timer) exits and the blend is done
+	ON_SCOPE_EXIT { MaskSwitchStats::MarkApplied(); };
+	RGBMASK_MASK_SWITCH_SCOPE(ApplyMaskChange);
+
 	bIsMaskChangeInProgress = false;
 
 	// Si la m�scara pendiente es la misma que la actual, solo limpiamos el flag
 	if (CurrentMask == PendingMask) return;
 
 	CurrentMask = PendingMask;
-	TObjectPtr<UMaterialInterface> ChosenMat;
-
-	switch (CurrentMask)
-	{
-	case EMaskType::Red:
-		ChosenMat = RedMaskMaterial;
-		break;
-	case EMaskType::Green:
-		ChosenMat = GreenMaskMaterial;
-		break;
-	case EMaskType::Blue:
-		ChosenMat = BlueMaskMaterial;
-		break;
-	case EMaskType::None:
-		ChosenMat = MainMaterial;
-		break;
-	default:
-		break;
-	}
+	UMaterialInterface* ChosenMat = MaskMeshMaterials[GetMaskIndex(CurrentMask)];
+
 	if (USkeletalMeshComponent* MeshComp = GetMesh())
 	{
 		const int32 NumMats = MeshComp->GetNumMaterials();
@@ -256,7 +234,11 @@ void ARGBMaskCharacter::ApplyMaskChange()
 		const int32 SafeIndex = FMath::Clamp(MaskMaterialIndex, 0, NumMats - 1);
 		MeshComp->SetMaterial(0, ChosenMat);
 	}
-	OnMaskChanged.Broadcast(CurrentMask);
+
+	{
+		RGBMASK_MASK_SWITCH_SCOPE(Broadcast);
+		OnMaskChanged.Broadcast(CurrentMask);
+	}
 
 	// Update post process effect based on new mask (only if NOT using smooth blending)
 	if (!bUseSmoothBlending)
@@ -266,62 +248,204 @@ void ARGBMaskCharacter::ApplyMaskChange()
 
 }
 
+void ARGBMaskCharacter::BuildMaskLookupTables()
+{
+	// Single place that maps EMaskType to assets: a new mask only needs a row here
+	MaskMeshMaterials[GetMaskIndex(EMaskType::Red)] = RedMaskMaterial;
+	MaskMeshMaterials[GetMaskIndex(EMaskType::Green)] = GreenMaskMaterial;
+	MaskMeshMaterials[GetMaskIndex(EMaskType::Blue)] = BlueMaskMaterial;
+	MaskMeshMaterials[GetMaskIndex(EMaskType::None)] = MainMaterial;
+
+	MaskPostProcessMaterials[GetMaskIndex(EMaskType::Red)] = RedPostProcessMaterial;
+	MaskPostProcessMaterials[GetMaskIndex(EMaskType::Green)] = GreenPostProcessMaterial;
+	MaskPostProcessMaterials[GetMaskIndex(EMaskType::Blue)] = BluePostProcessMaterial;
+	MaskPostProcessMaterials[GetMaskIndex(EMaskType::None)] = NonePostProcessMaterial;
+}
+
+UMaterialInstance* ARGBMaskCharacter::GetPostProcessMaterial(EMaskType Mask) const
+{
+	const int32 Index = GetMaskIndex(Mask);
+	return Index < NumMaskTypes ? MaskPostProcessMaterials[Index] : nullptr;
+}
+
+bool ARGBMaskCharacter::RegisterPostProcessBlendables()
+{
+	if (!PostProcessVolume)
+		return false;
+
+	TArray<FWeightedBlendable>& Blendables = PostProcessVolume->Settings.WeightedBlendables.Array;
+
+	if (IsUsingUberPostProcess())
+	{
+		if (UberPostProcessMID && Blendables.IsValidIndex(UberBlendableIndex) && Blendables[UberBlendableIndex].Object == UberPostProcessMID)
+			return true;
+
+		if (!UberPostProcessMID)
+		{
+			UberPostProcessMID = UMaterialInstanceDynamic::Create(UberPostProcessMaterial, this);
+		}
+
+		UberBlendableIndex = Blendables.IndexOfByPredicate([this](const FWeightedBlendable& Blendable) { return Blendable.Object == UberPostProcessMID; });
+		if (UberBlendableIndex == INDEX_NONE)
+		{
+			UberBlendableIndex = Blendables.Add(FWeightedBlendable(PostProcessBlendWeight, UberPostProcessMID));
+		}
+
+		UE_LOG(LogRGBMaskPostProcess, Verbose, TEXT("Registered uber mask post-process on %s"), *PostProcessVolume->GetName());
+		return true;
+	}
+
+	// Still registered? (someone else may have edited the volume's blendables)
+	bool bValid = true;
+	for (int32 MaskIndex = 0; MaskIndex < NumMaskTypes; ++MaskIndex)
+	{
+		UMaterialInstance* Mat = GetPostProcessMaterial(static_cast<EMaskType>(MaskIndex));
+		const int32 Index = PostProcessBlendableIndices[MaskIndex];
+		if (Mat && (!Blendables.IsValidIndex(Index) || Blendables[Index].Object != Mat))
+		{
+			bValid = false;
+			break;
+		}
+	}
+	if (bValid)
+		return true;
+
+	// Register each material once with weight 0, reusing an existing entry if the volume already has it
+	for (int32 MaskIndex = 0; MaskIndex < NumMaskTypes; ++MaskIndex)
+	{
+		UMaterialInstance* Mat = GetPostProcessMaterial(static_cast<EMaskType>(MaskIndex));
+		if (!Mat)
+		{
+			PostProcessBlendableIndices[MaskIndex] = INDEX_NONE;
+			continue;
+		}
+
+		int32 Index = Blendables.IndexOfByPredicate([Mat](const FWeightedBlendable& Blendable) { return Blendable.Object == Mat; });
+		if (Index == INDEX_NONE)
+		{
+			Index = Blendables.Add(FWeightedBlendable(0.0f, Mat));
+		}
+		PostProcessBlendableIndices[MaskIndex] = Index;
+	}
+
+	UE_LOG(LogRGBMaskPostProcess, Verbose, TEXT("Registered mask post-process blendables on %s (%d entries)"),
+		*PostProcessVolume->GetName(), Blendables.Num());
+	return true;
+}
+
+void ARGBMaskCharacter::UnregisterPostProcessBlendables()
+{
+	if (bIsBlendingPostProcess)
+	{
+		bIsBlendingPostProcess = false;
+		MaskSwitchStats::SetPostProcessPending(false);
+	}
+
+	if (!PostProcessVolume)
+		return;
+
+	TArray<FWeightedBlendable>& Blendables = PostProcessVolume->Settings.WeightedBlendables.Array;
+
+	if (UberPostProcessMID)
+	{
+		// Other characters re-resolve their indices when the entry they cached moves
+		Blendables.RemoveAll([this](const FWeightedBlendable& Blendable) { return Blendable.Object == UberPostProcessMID; });
+		UberPostProcessMID = nullptr;
+	}
+	UberBlendableIndex = INDEX_NONE;
+
+	// The per-mask materials are shared assets: keep the entries for the next character, just switch them off
+	for (int32& Index : PostProcessBlendableIndices)
+	{
+		if (Blendables.IsValidIndex(Index))
+		{
+			Blendables[Index].Weight = 0.0f;
+		}
+		Index = INDEX_NONE;
+	}
+}
+
+void ARGBMaskCharacter::ApplyPostProcessWeights(EMaskType From, EMaskType To, float Alpha)
+{
+	if (!RegisterPostProcessBlendables())
+		return;
+
+	TArray<FWeightedBlendable>& Blendables = PostProcessVolume->Settings.WeightedBlendables.Array;
+
+	if (IsUsingUberPostProcess())
+	{
+		// One pass: the material lerps between masks from the weights parameter
+		auto MaskWeights = [](EMaskType Mask)
+		{
+			switch (Mask)
+			{
+			case EMaskType::Red:   return FLinearColor(1.0f, 0.0f, 0.0f, 0.0f);
+			case EMaskType::Green: return FLinearColor(0.0f, 1.0f, 0.0f, 0.0f);
+			case EMaskType::Blue:  return FLinearColor(0.0f, 0.0f, 1.0f, 0.0f);
+			default:               return FLinearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			}
+		};
+
+		UberPostProcessMID->SetVectorParameterValue(MaskWeightsParameterName, FMath::Lerp(MaskWeights(From), MaskWeights(To), Alpha));
+		Blendables[UberBlendableIndex].Weight = PostProcessBlendWeight;
+		return;
+	}
+
+	// Zero every mask entry first: two masks may share the same material (and entry)
+	for (const int32 Index : PostProcessBlendableIndices)
+	{
+		if (Blendables.IsValidIndex(Index))
+		{
+			Blendables[Index].Weight = 0.0f;
+		}
+	}
+
+	const int32 FromIndex = PostProcessBlendableIndices[GetMaskIndex(From)];
+	const int32 ToIndex = PostProcessBlendableIndices[GetMaskIndex(To)];
+
+	if (Blendables.IsValidIndex(FromIndex))
+	{
+		Blendables[FromIndex].Weight += (1.0f - Alpha) * PostProcessBlendWeight;
+	}
+	if (Blendables.IsValidIndex(ToIndex))
+	{
+		Blendables[ToIndex].Weight += Alpha * PostProcessBlendWeight;
+	}
+}
+
 void ARGBMaskCharacter::UpdatePostProcess()
 {
+	RGBMASK_MASK_SWITCH_SCOPE(PostProcess);
+
 	// Early exit if post process effects are disabled or volume is not assigned
 	if (!bUsePostProcessEffects)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PostProcess disabled via bUsePostProcessEffects"));
+		UE_LOG(LogRGBMaskPostProcess, VeryVerbose, TEXT("PostProcess disabled via bUsePostProcessEffects"));
 		return;
 	}
 
 	if (!PostProcessVolume)
 	{
-		UE_LOG(LogTemp, Error, TEXT("PostProcessVolume is NULL! Cannot apply post-process."));
+		UE_LOG(LogRGBMaskPostProcess, Error, TEXT("PostProcessVolume is NULL! Cannot apply post-process."));
 		return;
 	}
 
-	TObjectPtr<UMaterialInstance> ChosenPostProcessMat = nullptr;
-
-	// Select the appropriate post process material based on current mask
-	switch (CurrentMask)
-	{
-	case EMaskType::Red:
-		ChosenPostProcessMat = RedPostProcessMaterial;
-		UE_LOG(LogTemp, Log, TEXT("Selecting RED post-process material"));
-		break;
-	case EMaskType::Green:
-		ChosenPostProcessMat = GreenPostProcessMaterial;
-		UE_LOG(LogTemp, Log, TEXT("Selecting GREEN post-process material"));
-		break;
-	case EMaskType::Blue:
-		ChosenPostProcessMat = BluePostProcessMaterial;
-		UE_LOG(LogTemp, Log, TEXT("Selecting BLUE post-process material"));
-		break;
-	case EMaskType::None:
-		ChosenPostProcessMat = NonePostProcessMaterial;
-		UE_LOG(LogTemp, Log, TEXT("Selecting NONE (default) post-process material"));
-		break;
-	default:
-		ChosenPostProcessMat = NonePostProcessMaterial;
-		UE_LOG(LogTemp, Warning, TEXT("Unknown mask type, using NONE post-process material"));
-		break;
-	}
-
-	// Apply the post process material if valid
-	if (ChosenPostProcessMat)
-	{
-		PostProcessVolume->Settings.WeightedBlendables.Array.Empty();
-		PostProcessVolume->Settings.WeightedBlendables.Array.Add(FWeightedBlendable(PostProcessBlendWeight, ChosenPostProcessMat));
-
-		UE_LOG(LogTemp, Log, TEXT("Applied post-process material: %s with weight: %f"),
+	// Only the current mask's blendable keeps its weight; the others stay registered at 0
+	ApplyPostProcessWeights(CurrentMask, CurrentMask, 1.0f);
+
+	if (IsUsingUberPostProcess())
+	{
+		UE_LOG(LogRGBMaskPostProcess, VeryVerbose, TEXT("Applied uber post-process for mask %d with weight: %f"),
+			(int)CurrentMask, PostProcessBlendWeight);
+	}
+	else if (UMaterialInstance* ChosenPostProcessMat = GetPostProcessMaterial(CurrentMask))
+	{
+		UE_LOG(LogRGBMaskPostProcess, VeryVerbose, TEXT("Applied post-process material: %s with weight: %f"),
 			*ChosenPostProcessMat->GetName(), PostProcessBlendWeight);
 	}
 	else
 	{
-		// Clear post process effects if no material is assigned
-		PostProcessVolume->Settings.WeightedBlendables.Array.Empty();
-		UE_LOG(LogTemp, Warning, TEXT("No post-process material assigned for current mask. Clearing effects."));
+		UE_LOG(LogRGBMaskPostProcess, Warning, TEXT("No post-process material assigned for current mask. Clearing effects."));
 	}
 }
 
@@ -335,144 +459,92 @@ void ARGBMaskCharacter::StartPostProcessBlend()
 	PostProcessBlendAlpha = 0.0f;
 	bIsBlendingPostProcess = true;
 
-	// Start the blend timer
-	if (UWorld* World = GetWorld())
-	{
-		World->GetTimerManager().SetTimer(
-			PostProcessBlendTimerHandle,
-			this,
-			&ARGBMaskCharacter::TickPostProcessBlend,
-			0.016f, // ~60 FPS
-			true
-		);
-	}
+	// The blend ticks belong to this switch: its timing stays open until the blend ends
+	MaskSwitchStats::SetPostProcessPending(true);
 }
 
-void ARGBMaskCharacter::TickPostProcessBlend()
+void ARGBMaskCharacter::TickPostProcessBlend(float DeltaSeconds)
 {
+	RGBMASK_MASK_SWITCH_SCOPE(PostProcess);
+
 	if (!bIsBlendingPostProcess || !PostProcessVolume)
+	{
+		bIsBlendingPostProcess = false;
+		MaskSwitchStats::SetPostProcessPending(false);
 		return;
+	}
 
 	// Increment blend alpha
-	if (UWorld* World = GetWorld())
-	{
-		PostProcessBlendAlpha += World->GetDeltaSeconds() / FMath::Max(PostProcessBlendDuration, 0.01f);
-	}
+	PostProcessBlendAlpha += DeltaSeconds / FMath::Max(PostProcessBlendDuration, 0.01f);
 
 	// Clamp to 0-1 range
 	PostProcessBlendAlpha = FMath::Clamp(PostProcessBlendAlpha, 0.0f, 1.0f);
 
-	// Get materials for previous and current masks
-	TObjectPtr<UMaterialInstance> PrevMat = nullptr;
-	TObjectPtr<UMaterialInstance> CurrMat = nullptr;
-
-	// Get previous mask material
-	switch (PreviousMask)
-	{
-	case EMaskType::Red:
-		PrevMat = RedPostProcessMaterial;
-		break;
-	case EMaskType::Green:
-		PrevMat = GreenPostProcessMaterial;
-		break;
-	case EMaskType::Blue:
-		PrevMat = BluePostProcessMaterial;
-		break;
-	case EMaskType::None:
-		PrevMat = NonePostProcessMaterial;
-		break;
-	}
-
-	// Get current mask material (pending)
-	switch (PendingMask)
-	{
-	case EMaskType::Red:
-		CurrMat = RedPostProcessMaterial;
-		break;
-	case EMaskType::Green:
-		CurrMat = GreenPostProcessMaterial;
-		break;
-	case EMaskType::Blue:
-		CurrMat = BluePostProcessMaterial;
-		break;
-	case EMaskType::None:
-		CurrMat = NonePostProcessMaterial;
-		break;
-	}
-
-	// Apply blended materials
-	PostProcessVolume->Settings.WeightedBlendables.Array.Empty();
-
-	if (PrevMat)
-	{
-		float PrevWeight = (1.0f - PostProcessBlendAlpha) * PostProcessBlendWeight;
-		PostProcessVolume->Settings.WeightedBlendables.Array.Add(FWeightedBlendable(PrevWeight, PrevMat));
-	}
-
-	if (CurrMat)
-	{
-		float CurrWeight = PostProcessBlendAlpha * PostProcessBlendWeight;
-		PostProcessVolume->Settings.WeightedBlendables.Array.Add(FWeightedBlendable(CurrWeight, CurrMat));
-	}
+	// Blend previous -> pending by weight only (no array changes)
+	ApplyPostProcessWeights(PreviousMask, PendingMask, PostProcessBlendAlpha);
 
 	// Check if blend is complete
 	if (PostProcessBlendAlpha >= 1.0f)
 	{
+		// Alpha 1 already leaves only the pending mask weighted. UpdatePostProcess would use
+		// CurrentMask, which is still the old one while MaskChangeDelay > PostProcessBlendDuration
 		bIsBlendingPostProcess = false;
-
-		if (UWorld* World = GetWorld())
-		{
-			World->GetTimerManager().ClearTimer(PostProcessBlendTimerHandle);
-		}
-
-		// Set final state
-		UpdatePostProcess();
+		MaskSwitchStats::SetPostProcessPending(false);
 	}
 }
 
 void ARGBMaskCharacter::AddMaskToInventory(EMaskType mask)
 {
-	Masks[mask] = true;
+	const int32 Bit = 1 << GetMaskIndex(mask);
+	if (MaskInventory & Bit) return;
+
+	MaskInventory |= Bit;
+	OnMaskInventoryChanged.Broadcast(mask, true);
 }
 
 void ARGBMaskCharacter::DeleteMask(EMaskType mask)
 {
-	Masks[mask] = false;
+	const int32 Bit = 1 << GetMaskIndex(mask);
+	if (!(MaskInventory & Bit)) return;
 
+	MaskInventory &= ~Bit;
+	OnMaskInventoryChanged.Broadcast(mask, false);
 }
 
 void ARGBMaskCharacter::DebugPrintPostProcessInfo()
 {
-	UE_LOG(LogTemp, Warning, TEXT("========== POST-PROCESS DEBUG INFO =========="));
-	UE_LOG(LogTemp, Warning, TEXT("Current Mask: %d"), (int)CurrentMask);
-	UE_LOG(LogTemp, Warning, TEXT("Pending Mask: %d"), (int)PendingMask);
-	UE_LOG(LogTemp, Warning, TEXT("bUsePostProcessEffects: %s"), bUsePostProcessEffects ? TEXT("TRUE") : TEXT("FALSE"));
-	UE_LOG(LogTemp, Warning, TEXT("bUseSmoothBlending: %s"), bUseSmoothBlending ? TEXT("TRUE") : TEXT("FALSE"));
-	UE_LOG(LogTemp, Warning, TEXT("PostProcessBlendWeight: %f"), PostProcessBlendWeight);
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("========== POST-PROCESS DEBUG INFO =========="));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("Current Mask: %d"), (int)CurrentMask);
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("Pending Mask: %d"), (int)PendingMask);
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("bUsePostProcessEffects: %s"), bUsePostProcessEffects ? TEXT("TRUE") : TEXT("FALSE"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("bUseSmoothBlending: %s"), bUseSmoothBlending ? TEXT("TRUE") : TEXT("FALSE"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("PostProcessBlendWeight: %f"), PostProcessBlendWeight);
 
 	if (PostProcessVolume)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PostProcessVolume: %s (VALID)"), *PostProcessVolume->GetName());
-		UE_LOG(LogTemp, Warning, TEXT("  - bUnbound: %s"), PostProcessVolume->bUnbound ? TEXT("TRUE") : TEXT("FALSE"));
-		UE_LOG(LogTemp, Warning, TEXT("  - Priority: %f"), PostProcessVolume->Priority);
-		UE_LOG(LogTemp, Warning, TEXT("  - BlendWeight: %f"), PostProcessVolume->BlendWeight);
-		UE_LOG(LogTemp, Warning, TEXT("  - Num Blendables: %d"), PostProcessVolume->Settings.WeightedBlendables.Array.Num());
+		UE_LOG(LogRGBMaskPostProcess, Log, TEXT("PostProcessVolume: %s (VALID)"), *PostProcessVolume->GetName());
+		UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - bUnbound: %s"), PostProcessVolume->bUnbound ? TEXT("TRUE") : TEXT("FALSE"));
+		UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - Priority: %f"), PostProcessVolume->Priority);
+		UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - BlendWeight: %f"), PostProcessVolume->BlendWeight);
+		UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - Num Blendables: %d"), PostProcessVolume->Settings.WeightedBlendables.Array.Num());
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("PostProcessVolume: NULL"));
+		UE_LOG(LogRGBMaskPostProcess, Error, TEXT("PostProcessVolume: NULL"));
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("Materials Assigned:"));
-	UE_LOG(LogTemp, Warning, TEXT("  - Red: %s"), RedPostProcessMaterial ? *RedPostProcessMaterial->GetName() : TEXT("NULL"));
-	UE_LOG(LogTemp, Warning, TEXT("  - Green: %s"), GreenPostProcessMaterial ? *GreenPostProcessMaterial->GetName() : TEXT("NULL"));
-	UE_LOG(LogTemp, Warning, TEXT("  - Blue: %s"), BluePostProcessMaterial ? *BluePostProcessMaterial->GetName() : TEXT("NULL"));
-	UE_LOG(LogTemp, Warning, TEXT("  - None: %s"), NonePostProcessMaterial ? *NonePostProcessMaterial->GetName() : TEXT("NULL"));
-	UE_LOG(LogTemp, Warning, TEXT("============================================="));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("Materials Assigned:"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - Red: %s"), RedPostProcessMaterial ? *RedPostProcessMaterial->GetName() : TEXT("NULL"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - Green: %s"), GreenPostProcessMaterial ? *GreenPostProcessMaterial->GetName() : TEXT("NULL"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - Blue: %s"), BluePostProcessMaterial ? *BluePostProcessMaterial->GetName() : TEXT("NULL"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - None: %s"), NonePostProcessMaterial ? *NonePostProcessMaterial->GetName() : TEXT("NULL"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("  - Uber: %s (%s)"), UberPostProcessMaterial ? *UberPostProcessMaterial->GetName() : TEXT("NULL"),
+		IsUsingUberPostProcess() ? TEXT("ACTIVE") : TEXT("inactive"));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("============================================="));
 }
 
 void ARGBMaskCharacter::ForceUpdatePostProcess()
 {
-	UE_LOG(LogTemp, Warning, TEXT("FORCING PostProcess Update..."));
+	UE_LOG(LogRGBMaskPostProcess, Log, TEXT("FORCING PostProcess Update..."));
 	UpdatePostProcess();
 }
\ No newline at end of file
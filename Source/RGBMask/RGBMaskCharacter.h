@@ -11,9 +11,11 @@
 class UCameraComponent;
 class USpringArmComponent;
 class APostProcessVolume;
+class UMaterialInstanceDynamic;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMaskChanged, EMaskType, MaskType);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMaskChangeStarted, EMaskType, MaskType);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMaskInventoryChanged, EMaskType, MaskType, bool, bOwned);
 
 /**
  *  A controllable top-down perspective character
@@ -56,14 +58,49 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Mask|PostProcess|Advanced", meta = (ClampMin = "0.0"))
 	float PostProcessBlendDuration = 0.3f;
 
-	FTimerHandle PostProcessBlendTimerHandle;
 	float PostProcessBlendAlpha = 0.0f;
 	EMaskType PreviousMask = EMaskType::None;
 	bool bIsBlendingPostProcess = false;
 
-	void TickPostProcessBlend();
+	/** Advanced from Tick while a blend is running */
+	void TickPostProcessBlend(float DeltaSeconds);
 	void StartPostProcessBlend();
 
+	/** Index of each mask's material in PostProcessVolume's WeightedBlendables (indexed by EMaskType) */
+	int32 PostProcessBlendableIndices[NumMaskTypes];
+
+	/** Per-mask lookup tables built from the material properties in BeginPlay (indexed by EMaskType) */
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInterface> MaskMeshMaterials[NumMaskTypes];
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstance> MaskPostProcessMaterials[NumMaskTypes];
+
+	void BuildMaskLookupTables();
+
+	/** Owned masks, one bit per EMaskType */
+	UPROPERTY(EditAnywhere, Category = "Mask", meta = (Bitmask, BitmaskEnum = "/Script/RGBMask.EMaskType"))
+	int32 MaskInventory = 0;
+
+	/** Adds the four mask materials to the volume once (weight 0); afterwards only their weights change */
+	bool RegisterPostProcessBlendables();
+
+	/** Removes this character's uber entry from PostProcessVolume and zeroes the per-mask weights */
+	void UnregisterPostProcessBlendables();
+
+	/** Weights the persistent blendables: From gets (1 - Alpha), To gets Alpha, everything else 0 */
+	void ApplyPostProcessWeights(EMaskType From, EMaskType To, float Alpha);
+
+	UMaterialInstance* GetPostProcessMaterial(EMaskType Mask) const;
+
+	/** Dynamic instance of UberPostProcessMaterial, registered as the only mask blendable in uber mode */
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> UberPostProcessMID;
+
+	int32 UberBlendableIndex = INDEX_NONE;
+
+	bool IsUsingUberPostProcess() const { return bUseUberPostProcess && UberPostProcessMaterial != nullptr; }
+
 	UPROPERTY(EditAnywhere, Category = "Camera")
 	float CameraDistance = 800.f;
 
@@ -79,6 +116,9 @@ public:
 	/** Initialization */
 	virtual void BeginPlay() override;
 
+	/** Cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Update */
 	virtual void Tick(float DeltaSeconds) override;
 
@@ -90,7 +130,8 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	EMaskType GetMask() const { return CurrentMask; }
-	void SetMask(EMaskType NewMask);
+	/** InputTime: FPlatformTime::Seconds() of the input that asked for the switch (for rgbmask.MaskSwitchTimings, 0 = now) */
+	void SetMask(EMaskType NewMask, double InputTime = 0.0);
 
 	UPROPERTY(EditDefaultsOnly, Category = "Mask|Materials")
 	TObjectPtr<UMaterialInterface> RedMaskMaterial;
@@ -106,7 +147,7 @@ public:
 	// ============================================
 
 	/**
-	 * PostProcessVolume reference - will be auto-detected from the level.
+	 * PostProcessVolume reference - resolved through UMaskPostProcessSubsystem (tagged MaskPostProcess, else unbound).
 	 * You can also manually assign it by selecting this character in the level (not in BP defaults!)
 	 */
 	UPROPERTY(VisibleInstanceOnly, Category = "Mask|PostProcess|Debug")
@@ -133,13 +174,31 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Mask|PostProcess|Advanced")
 	bool bUseSmoothBlending = false;  // Changed to false by default for easier debugging
 
+	/**
+	 * Use a single post-process material for every mask instead of the four per-mask materials.
+	 * Transitions become a parameter lerp on one full-screen pass instead of two weighted passes.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Mask|PostProcess|Uber")
+	bool bUseUberPostProcess = false;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Mask|PostProcess|Uber", meta = (EditCondition = "bUseUberPostProcess"))
+	TObjectPtr<UMaterialInterface> UberPostProcessMaterial;
+
+	/** Vector parameter receiving the mask weights as (Red, Green, Blue, None) */
+	UPROPERTY(EditDefaultsOnly, Category = "Mask|PostProcess|Uber", meta = (EditCondition = "bUseUberPostProcess"))
+	FName MaskWeightsParameterName = TEXT("MaskWeights");
+
 	UPROPERTY(BlueprintAssignable)
 	FOnMaskChanged OnMaskChanged;
 
 	UPROPERTY(BlueprintAssignable)
 	FOnMaskChangeStarted OnMaskChangeStarted;
 
-	TMap<EMaskType, bool> Masks;
+	UPROPERTY(BlueprintAssignable)
+	FOnMaskInventoryChanged OnMaskInventoryChanged;
+
+	UFUNCTION(BlueprintPure, Category = "Mask")
+	bool HasMask(EMaskType Mask) const { return (MaskInventory >> GetMaskIndex(Mask)) & 1; }
 
 	UFUNCTION(BlueprintCallable, Category = "Mask")
 
@@ -149,7 +208,8 @@ public:
 	void DeleteMask(EMaskType mask);
 
 	// DEBUG FUNCTIONS
-	UFUNCTION(BlueprintCallable, Category = "Mask|PostProcess|Debug")
+	/** Dumps the post-process state to the log. Console: DebugPrintPostProcessInfo */
+	UFUNCTION(Exec, BlueprintCallable, Category = "Mask|PostProcess|Debug")
 	void DebugPrintPostProcessInfo();
 
 	UFUNCTION(BlueprintCallable, Category = "Mask|PostProcess|Debug")
@@ -4,7 +4,7 @@
 #include "GameFramework/Pawn.h"
 #include "Blueprint/AIBlueprintHelperLibrary.h"
 #include "NiagaraSystem.h"
-#include "NiagaraFunctionLibrary.h"
+#include "CursorFXPoolComponent.h"
 #include "RGBMaskCharacter.h"
 #include "Engine/World.h"
 #include "CameraShakeSubsystem.h"
@@ -15,6 +15,7 @@
 #include "Engine/LocalPlayer.h"
 #include "RGBMask/Public/Camera/RGBMaskCameraManager.h"
 #include "RGBMask.h"
+#include "MaskSwitchStats.h"
 
 ARGBMaskPlayerController::ARGBMaskPlayerController()
 {
@@ -26,6 +27,9 @@ ARGBMaskPlayerController::ARGBMaskPlayerController()
 
 	// create the path following comp
 	PathFollowingComponent = CreateDefaultSubobject<UPathFollowingComponent>(TEXT("Path Following Component"));
+
+	// create the cursor FX pool
+	CursorFXPool = CreateDefaultSubobject<UCursorFXPoolComponent>(TEXT("Cursor FX Pool"));
 	
 	// configure the controller
 	bShowMouseCursor = true;
@@ -33,6 +37,8 @@ ARGBMaskPlayerController::ARGBMaskPlayerController()
 	CachedDestination = FVector::ZeroVector;
 	FollowTime = 0.f;
 
+	CursorTraceDelegate.BindUObject(this, &ARGBMaskPlayerController::OnCursorTraceDone);
+
 }
 
 void ARGBMaskPlayerController::SetupInputComponent()
@@ -87,8 +93,8 @@ void ARGBMaskPlayerController::OnInputStarted()
 {
 	StopMovement();
 
-	// Update the move destination to wherever the cursor is pointing at
-	UpdateCachedDestination();
+	// Update the move destination to wherever the cursor is pointing at (new press: always trace)
+	UpdateCachedDestination(true);
 }
 
 void ARGBMaskPlayerController::OnSetDestinationTriggered()
@@ -115,7 +121,7 @@ void ARGBMaskPlayerController::OnSetDestinationReleased()
 	{
 		// We move there and spawn some particles
 		UAIBlueprintHelperLibrary::SimpleMoveToLocation(this, CachedDestination);
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, FXCursor, CachedDestination, FRotator::ZeroRotator, FVector(1.f, 1.f, 1.f), true, true, ENCPoolMethod::None, true);
+		CursorFXPool->PlayAt(FXCursor, CachedDestination);
 	}
 
 	FollowTime = 0.f;
@@ -163,15 +169,15 @@ void ARGBMaskPlayerController::OnChangeRedMask()
 	ARGBMaskCharacter* MaskCharacter = Cast<ARGBMaskCharacter>(GetPawn());
 	if (!MaskCharacter)
 	{
-		UE_LOG(LogRGBMask, Warning, TEXT("ToggleMask: Pawn no es ARGBMaskCharacter"));
+		UE_LOG(LogRGBMaskMasks, Warning, TEXT("ToggleMask: Pawn no es ARGBMaskCharacter"));
 		return;
 	}
-	if (MaskCharacter->Masks[EMaskType::Red])
+	if (MaskCharacter->HasMask(EMaskType::Red))
 	{
 		ToggleMask(EMaskType::Red, MaskCharacter);
 	}
 
-	UE_LOG(LogRGBMask, Error, TEXT("Mask Red"));
+	UE_LOG(LogRGBMaskMasks, VeryVerbose, TEXT("Mask Red"));
 
 }
 
@@ -180,14 +186,14 @@ void ARGBMaskPlayerController::OnChangeBlueMask()
 	ARGBMaskCharacter* MaskCharacter = Cast<ARGBMaskCharacter>(GetPawn());
 	if (!MaskCharacter)
 	{
-		UE_LOG(LogRGBMask, Warning, TEXT("ToggleMask: Pawn no es ARGBMaskCharacter"));
+		UE_LOG(LogRGBMaskMasks, Warning, TEXT("ToggleMask: Pawn no es ARGBMaskCharacter"));
 		return;
 	}
-	if (MaskCharacter->Masks[EMaskType::Blue])
+	if (MaskCharacter->HasMask(EMaskType::Blue))
 	{
 		ToggleMask(EMaskType::Blue, MaskCharacter);
 	}
-	UE_LOG(LogRGBMask, Error, TEXT("Mask Blue"));
+	UE_LOG(LogRGBMaskMasks, VeryVerbose, TEXT("Mask Blue"));
 
 
 }
@@ -197,14 +203,14 @@ void ARGBMaskPlayerController::OnChangeGreenMask()
 	ARGBMaskCharacter* MaskCharacter = Cast<ARGBMaskCharacter>(GetPawn());
 	if (!MaskCharacter)
 	{
-		UE_LOG(LogRGBMask, Warning, TEXT("ToggleMask: Pawn no es ARGBMaskCharacter"));
+		UE_LOG(LogRGBMaskMasks, Warning, TEXT("ToggleMask: Pawn no es ARGBMaskCharacter"));
 		return;
 	}
-	if (MaskCharacter->Masks[EMaskType::Green]) 
+	if (MaskCharacter->HasMask(EMaskType::Green)) 
 	{
 		ToggleMask(EMaskType::Green, MaskCharacter);
 	}
-	UE_LOG(LogRGBMask, Error, TEXT("Mask Green"));
+	UE_LOG(LogRGBMaskMasks, VeryVerbose, TEXT("Mask Green"));
 
 }
 
@@ -214,7 +220,7 @@ void ARGBMaskPlayerController::OnCameraShake()
 	{
 		if (UCameraShakeSubsystem* ShakeSub = w->GetSubsystem<UCameraShakeSubsystem>()) 
 		{
-			ShakeSub->PlayShake();
+			ShakeSub->PlayShakeByTag(CameraShakeProfile, FVector::ZeroVector, 1.0f, this);
 		}
 	}
 }
@@ -225,7 +231,12 @@ void ARGBMaskPlayerController::ToggleMask(EMaskType DesiredMask, ARGBMaskCharact
 	if (!bCanToggleMask) return;
 	const EMaskType Current = MaskCharacter->GetMask();
 	const EMaskType NewMask = (Current == DesiredMask) ? EMaskType::None : DesiredMask;
-	MaskCharacter->SetMask(NewMask);
+
+	// the switch timing starts at the input, but the record is only opened by SetMask if the switch happens
+	const double InputTime = FPlatformTime::Seconds();
+	RGBMASK_MASK_SWITCH_SCOPE(Toggle);
+
+	MaskCharacter->SetMask(NewMask, InputTime);
 	if (NewMask == Current)
 		return;
 	bCanToggleMask = false;
@@ -242,8 +253,44 @@ void ARGBMaskPlayerController::ToggleMask(EMaskType DesiredMask, ARGBMaskCharact
 	}
 }
 
-void ARGBMaskPlayerController::UpdateCachedDestination()
+void ARGBMaskPlayerController::UpdateCachedDestination(bool bForceTrace)
 {
+	FVector2D ScreenPosition;
+	const bool bHasScreenPosition = GetPointerScreenPosition(ScreenPosition);
+
+	// While held, reuse the surface hit by the last full trace as long as the cursor stays close to it
+	if (bThrottleCursorTrace && !bForceTrace && bHasCachedGround && bHasScreenPosition
+		&& FVector2D::DistSquared(ScreenPosition, LastTracedScreenPosition) <= FMath::Square(CursorRetraceScreenThreshold))
+	{
+		FVector Reprojected;
+		if (ReprojectOntoCachedGround(ScreenPosition, Reprojected))
+		{
+			CachedDestination = Reprojected;
+			return;
+		}
+	}
+
+	// Async fallback: keep the plane estimate this frame, the trace result refreshes the cache
+	if (bThrottleCursorTrace && bAsyncCursorTrace && !bForceTrace && bHasScreenPosition)
+	{
+		UWorld* World = GetWorld();
+		FVector WorldOrigin, WorldDirection;
+		if (World && !World->IsTraceHandleValid(PendingCursorTrace, false)
+			&& DeprojectScreenPositionToWorld(ScreenPosition.X, ScreenPosition.Y, WorldOrigin, WorldDirection))
+		{
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(RGBMaskCursorTrace), true);
+			PendingCursorTrace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, WorldOrigin, WorldOrigin + WorldDirection * HitResultTraceDistance,
+				ECollisionChannel::ECC_Visibility, Params, FCollisionResponseParams::DefaultResponseParam, &CursorTraceDelegate);
+		}
+
+		FVector Reprojected;
+		if (bHasCachedGround && ReprojectOntoCachedGround(ScreenPosition, Reprojected))
+		{
+			CachedDestination = Reprojected;
+		}
+		return;
+	}
+
 	// We look for the location in the world where the player has pressed the input
 	FHitResult Hit;
 	bool bHitSuccessful = false;
@@ -260,7 +307,81 @@ void ARGBMaskPlayerController::UpdateCachedDestination()
 	if (bHitSuccessful)
 	{
 		CachedDestination = Hit.Location;
+		CacheCursorHit(Hit.Location, Hit.ImpactNormal, ScreenPosition);
+	}
+}
+
+bool ARGBMaskPlayerController::GetPointerScreenPosition(FVector2D& OutScreenPosition) const
+{
+	if (bIsTouch)
+	{
+		bool bIsPressed = false;
+		GetInputTouchState(ETouchIndex::Touch1, OutScreenPosition.X, OutScreenPosition.Y, bIsPressed);
+		return bIsPressed;
+	}
+
+	float MouseX, MouseY;
+	if (!GetMousePosition(MouseX, MouseY))
+	{
+		return false;
 	}
+	OutScreenPosition = FVector2D(MouseX, MouseY);
+	return true;
+}
+
+bool ARGBMaskPlayerController::ReprojectOntoCachedGround(const FVector2D& ScreenPosition, FVector& OutLocation) const
+{
+	FVector WorldOrigin, WorldDirection;
+	if (!DeprojectScreenPositionToWorld(ScreenPosition.X, ScreenPosition.Y, WorldOrigin, WorldDirection))
+	{
+		return false;
+	}
+
+	// Ray nearly parallel to the surface: the intersection is meaningless
+	if (FMath::Abs(FVector::DotProduct(WorldDirection, FVector(CachedGroundPlane))) < KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector Location = FMath::RayPlaneIntersection(WorldOrigin, WorldDirection, CachedGroundPlane);
+
+	// Left the surface we traced: a full trace has to decide what is under the cursor now
+	if (FVector::DistSquared(Location, CachedGroundAnchor) > FMath::Square(CursorSurfaceExtent))
+	{
+		return false;
+	}
+
+	OutLocation = Location;
+	return true;
+}
+
+void ARGBMaskPlayerController::CacheCursorHit(const FVector& Location, const FVector& Normal, const FVector2D& ScreenPosition)
+{
+	CachedGroundPlane = FPlane(Location, Normal.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector));
+	CachedGroundAnchor = Location;
+	LastTracedScreenPosition = ScreenPosition;
+	bHasCachedGround = true;
+}
+
+void ARGBMaskPlayerController::OnCursorTraceDone(const FTraceHandle& Handle, FTraceDatum& Data)
+{
+	PendingCursorTrace = FTraceHandle();
+
+	if (Data.OutHits.Num() == 0 || !Data.OutHits[0].bBlockingHit)
+	{
+		return;
+	}
+
+	const FHitResult& Hit = Data.OutHits[0];
+
+	FVector2D ScreenPosition;
+	if (!ProjectWorldLocationToScreen(Hit.Location, ScreenPosition))
+	{
+		return;
+	}
+
+	CachedDestination = Hit.Location;
+	CacheCursorHit(Hit.Location, Hit.ImpactNormal, ScreenPosition);
 }
 
 void ARGBMaskPlayerController::ResetMaskToggleCooldown()
@@ -7,12 +7,14 @@
 //#include "Templates/SubclassOf.h"
 #include "GameFramework/PlayerController.h"
 #include "TimerManager.h"
+#include "WorldCollision.h"
 #include "RGBMaskPlayerController.generated.h"
 
 class UNiagaraSystem;
 class UInputMappingContext;
 class UInputAction;
 class UPathFollowingComponent;
+class UCursorFXPoolComponent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
@@ -39,6 +41,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input")
 	TObjectPtr<UNiagaraSystem> FXCursor;
 
+	/** Reusable Niagara components for FXCursor (rapid clicks restart the oldest one) */
+	UPROPERTY(VisibleDefaultsOnly, Category = "Input")
+	TObjectPtr<UCursorFXPoolComponent> CursorFXPool;
+
 	/** MappingContext */
 	UPROPERTY(EditAnywhere, Category="Input")
 	TObjectPtr<UInputMappingContext> DefaultMappingContext;
@@ -65,6 +71,10 @@ protected:
 	TObjectPtr<UInputAction> GreenMask;
 	UPROPERTY(EditAnywhere, Category = "Input")
 	TObjectPtr<UInputAction> CameraShake;
+
+	/** Shake profile (UCameraShakeCatalog tag) played by the CameraShake action */
+	UPROPERTY(EditAnywhere, Category = "Input")
+	FName CameraShakeProfile = TEXT("Default");
 	/** True if the controlled character should navigate to the mouse cursor. */
 	uint32 bMoveToMouseCursor : 1;
 
@@ -77,6 +87,31 @@ protected:
 	/** Time that the click input has been pressed */
 	float FollowTime = 0.0f;
 
+	/** If true, a held move reprojects the cursor onto the last hit surface instead of tracing every frame */
+	UPROPERTY(EditAnywhere, Category="Input|Cursor Trace")
+	bool bThrottleCursorTrace = true;
+
+	/** Screen distance (pixels) the cursor can move from the last full trace before tracing again */
+	UPROPERTY(EditAnywhere, Category="Input|Cursor Trace", meta = (EditCondition = "bThrottleCursorTrace", ClampMin = "0.0"))
+	float CursorRetraceScreenThreshold = 24.0f;
+
+	/** World distance (cm) from the last hit beyond which the cached ground plane is no longer trusted */
+	UPROPERTY(EditAnywhere, Category="Input|Cursor Trace", meta = (EditCondition = "bThrottleCursorTrace", ClampMin = "0.0"))
+	float CursorSurfaceExtent = 400.0f;
+
+	/** Run the fallback trace asynchronously (result lands next frame; the plane is used meanwhile) */
+	UPROPERTY(EditAnywhere, Category="Input|Cursor Trace", meta = (EditCondition = "bThrottleCursorTrace"))
+	bool bAsyncCursorTrace = false;
+
+	/** Surface under the cursor at the last full trace */
+	FPlane CachedGroundPlane;
+	FVector CachedGroundAnchor = FVector::ZeroVector;
+	FVector2D LastTracedScreenPosition = FVector2D::ZeroVector;
+	bool bHasCachedGround = false;
+
+	FTraceHandle PendingCursorTrace;
+	FTraceDelegate CursorTraceDelegate;
+
 public:
 
 	/** Constructor */
@@ -101,8 +136,13 @@ protected:
 
 	void ToggleMask(EMaskType DesiredMask, class ARGBMaskCharacter* MaskCharacter);
 
-	/** Helper function to get the move destination */
-	void UpdateCachedDestination();
+	/** Helper function to get the move destination. bForceTrace skips the cached ground plane */
+	void UpdateCachedDestination(bool bForceTrace = false);
+
+	bool GetPointerScreenPosition(FVector2D& OutScreenPosition) const;
+	bool ReprojectOntoCachedGround(const FVector2D& ScreenPosition, FVector& OutLocation) const;
+	void CacheCursorHit(const FVector& Location, const FVector& Normal, const FVector2D& ScreenPosition);
+	void OnCursorTraceDone(const FTraceHandle& Handle, FTraceDatum& Data);
 private:
 	UPROPERTY(EditAnywhere, Category = "Mask|Cooldown", meta = (ClampMin = "0.0"))
 	float MaskToggleCooldownSeconds = 0.5f;
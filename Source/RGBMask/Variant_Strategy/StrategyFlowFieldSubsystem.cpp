@@ -0,0 +1,291 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyFlowFieldSubsystem.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+
+namespace StrategyFlowField
+{
+	/** Grid offsets to the eight neighbors of a cell. The first four are the straight ones */
+	static const FIntPoint NeighborOffsets[8] =
+	{
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+
+	/** Open list entry for the integration pass */
+	struct FOpenCell
+	{
+		int32 Index;
+		float Cost;
+
+		bool operator<(const FOpenCell& Other) const { return Cost < Other.Cost; }
+	};
+}
+
+FIntPoint FStrategyFlowField::GetCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32((Location.X - Origin.X) / CellSize),
+		FMath::FloorToInt32((Location.Y - Origin.Y) / CellSize));
+}
+
+bool FStrategyFlowField::ContainsArea(const FBox2D& Area) const
+{
+	const FVector2D Max = Origin + FVector2D(Width, Height) * CellSize;
+
+	return Area.Min.X >= Origin.X && Area.Min.Y >= Origin.Y && Area.Max.X <= Max.X && Area.Max.Y <= Max.Y;
+}
+
+bool FStrategyFlowField::SampleDirection(const FVector& Location, FVector& OutDirection) const
+{
+	const FIntPoint Cell = GetCell(Location);
+
+	// is the location outside the grid?
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= Width || Cell.Y >= Height)
+	{
+		return false;
+	}
+
+	// can this cell reach the goal?
+	const int32 Index = Cell.Y * Width + Cell.X;
+
+	if (Costs[Index] == MAX_flt)
+	{
+		return false;
+	}
+
+	OutDirection = FVector(Directions[Index].X, Directions[Index].Y, 0.0f);
+	return true;
+}
+
+void UStrategyFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// cached fields go stale when the navmesh changes
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &UStrategyFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+}
+
+void UStrategyFlowFieldSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UStrategyFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+
+	InvalidateFields();
+
+	Super::Deinitialize();
+}
+
+TSharedPtr<const FStrategyFlowField> UStrategyFlowFieldSubsystem::FindOrBuildField(const FVector& Goal, const FBox2D& Area)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// reuse a cached field if it leads to the same goal cell and covers the area
+	for (const TSharedPtr<FStrategyFlowField>& Field : CachedFields)
+	{
+		if (Field->GetCell(Goal) == Field->GetCell(Field->Goal) && Field->ContainsArea(Area))
+		{
+			Field->LastUsedTime = Now;
+			return Field;
+		}
+	}
+
+	TSharedPtr<FStrategyFlowField> NewField = BuildField(Goal, Area);
+
+	if (!NewField.IsValid())
+	{
+		return nullptr;
+	}
+
+	NewField->LastUsedTime = Now;
+
+	// evict the least recently used field if the cache is full
+	if (CachedFields.Num() >= MaxCachedFields)
+	{
+		int32 OldestIndex = 0;
+
+		for (int32 i = 1; i < CachedFields.Num(); ++i)
+		{
+			if (CachedFields[i]->LastUsedTime < CachedFields[OldestIndex]->LastUsedTime)
+			{
+				OldestIndex = i;
+			}
+		}
+
+		CachedFields.RemoveAtSwap(OldestIndex);
+	}
+
+	CachedFields.Add(NewField);
+
+	return NewField;
+}
+
+void UStrategyFlowFieldSubsystem::InvalidateFields()
+{
+	CachedFields.Empty();
+}
+
+TSharedPtr<FStrategyFlowField> UStrategyFlowFieldSubsystem::BuildField(const FVector& Goal, const FBox2D& Area) const
+{
+	using namespace StrategyFlowField;
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+	if (!NavData)
+	{
+		return nullptr;
+	}
+
+	// cover the requested area and the goal, plus a margin to route around obstacles
+	FBox2D FieldArea = Area;
+	FieldArea += FVector2D(Goal);
+	FieldArea = FieldArea.ExpandBy(FieldMargin);
+
+	const FVector2D AreaSize = FieldArea.GetSize();
+
+	TSharedPtr<FStrategyFlowField> Field = MakeShared<FStrategyFlowField>();
+	Field->Goal = Goal;
+	Field->Origin = FieldArea.Min;
+	Field->CellSize = FMath::Max(CellSize, AreaSize.GetMax() / MaxCellsPerSide);
+	Field->Width = FMath::CeilToInt32(AreaSize.X / Field->CellSize);
+	Field->Height = FMath::CeilToInt32(AreaSize.Y / Field->CellSize);
+
+	const int32 NumCells = Field->Width * Field->Height;
+
+	// mark the walkable cells by projecting each cell center onto the navmesh
+	TBitArray<> Walkable(false, NumCells);
+
+	const FVector ProjectionExtent(Field->CellSize * 0.5f, Field->CellSize * 0.5f, ProjectionHeight);
+
+	for (int32 Y = 0; Y < Field->Height; ++Y)
+	{
+		for (int32 X = 0; X < Field->Width; ++X)
+		{
+			const FVector CellCenter(Field->Origin.X + (X + 0.5f) * Field->CellSize, Field->Origin.Y + (Y + 0.5f) * Field->CellSize, Goal.Z);
+
+			FNavLocation NavLocation;
+			Walkable[Y * Field->Width + X] = NavData->ProjectPoint(CellCenter, NavLocation, ProjectionExtent);
+		}
+	}
+
+	// integrate the cost to the goal with Dijkstra over the eight-connected grid
+	Field->Costs.Init(MAX_flt, NumCells);
+	Field->Directions.Init(FVector2f::ZeroVector, NumCells);
+
+	const FIntPoint GoalCell = Field->GetCell(Goal);
+	const int32 GoalIndex = GoalCell.Y * Field->Width + GoalCell.X;
+
+	// the goal cell is always treated as walkable so the field has somewhere to lead to
+	Walkable[GoalIndex] = true;
+	Field->Costs[GoalIndex] = 0.0f;
+
+	TArray<FOpenCell> OpenList;
+	OpenList.HeapPush(FOpenCell{ GoalIndex, 0.0f });
+
+	while (OpenList.Num() > 0)
+	{
+		FOpenCell Current;
+		OpenList.HeapPop(Current, EAllowShrinking::No);
+
+		// skip entries made stale by a cheaper path
+		if (Current.Cost > Field->Costs[Current.Index])
+		{
+			continue;
+		}
+
+		const int32 CurrentX = Current.Index % Field->Width;
+		const int32 CurrentY = Current.Index / Field->Width;
+
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NeighborX = CurrentX + NeighborOffsets[i].X;
+			const int32 NeighborY = CurrentY + NeighborOffsets[i].Y;
+
+			if (NeighborX < 0 || NeighborY < 0 || NeighborX >= Field->Width || NeighborY >= Field->Height)
+			{
+				continue;
+			}
+
+			const int32 NeighborIndex = NeighborY * Field->Width + NeighborX;
+
+			if (!Walkable[NeighborIndex])
+			{
+				continue;
+			}
+
+			// don't cut corners past blocked cells on diagonal steps
+			const bool bDiagonal = i >= 4;
+
+			if (bDiagonal && (!Walkable[CurrentY * Field->Width + NeighborX] || !Walkable[NeighborY * Field->Width + CurrentX]))
+			{
+				continue;
+			}
+
+			const float NewCost = Current.Cost + (bDiagonal ? UE_SQRT_2 : 1.0f);
+
+			if (NewCost < Field->Costs[NeighborIndex])
+			{
+				Field->Costs[NeighborIndex] = NewCost;
+				OpenList.HeapPush(FOpenCell{ NeighborIndex, NewCost });
+			}
+		}
+	}
+
+	// point each reachable cell towards its cheapest neighbor
+	for (int32 Index = 0; Index < NumCells; ++Index)
+	{
+		if (Index == GoalIndex || Field->Costs[Index] == MAX_flt)
+		{
+			continue;
+		}
+
+		const int32 CellX = Index % Field->Width;
+		const int32 CellY = Index / Field->Width;
+
+		float BestCost = Field->Costs[Index];
+		FIntPoint BestOffset = FIntPoint::ZeroValue;
+
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NeighborX = CellX + NeighborOffsets[i].X;
+			const int32 NeighborY = CellY + NeighborOffsets[i].Y;
+
+			if (NeighborX < 0 || NeighborY < 0 || NeighborX >= Field->Width || NeighborY >= Field->Height)
+			{
+				continue;
+			}
+
+			// apply the same corner rule as the integration pass
+			if (i >= 4 && (!Walkable[CellY * Field->Width + NeighborX] || !Walkable[NeighborY * Field->Width + CellX]))
+			{
+				continue;
+			}
+
+			const float NeighborCost = Field->Costs[NeighborY * Field->Width + NeighborX];
+
+			if (NeighborCost < BestCost)
+			{
+				BestCost = NeighborCost;
+				BestOffset = NeighborOffsets[i];
+			}
+		}
+
+		Field->Directions[Index] = FVector2f(BestOffset.X, BestOffset.Y).GetSafeNormal();
+	}
+
+	return Field;
+}
+
+void UStrategyFlowFieldSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	InvalidateFields();
+}
@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrategyFlowFieldSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ *  Integration field over a 2D grid, pointing every reachable cell towards a goal
+ *  Walkable cells come from projecting each cell center onto the navmesh
+ */
+struct FStrategyFlowField
+{
+	/** Goal location the field leads to */
+	FVector Goal = FVector::ZeroVector;
+
+	/** World XY location of the grid's minimum corner */
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	/** Size of each grid cell, in world units */
+	float CellSize = 100.0f;
+
+	/** Number of cells along X */
+	int32 Width = 0;
+
+	/** Number of cells along Y */
+	int32 Height = 0;
+
+	/** Integrated cost from each cell to the goal. Unreachable cells are set to MAX_flt */
+	TArray<float> Costs;
+
+	/** Normalized direction to the cheapest neighbor for each cell. Zero on the goal cell */
+	TArray<FVector2f> Directions;
+
+	/** World time when this field was last requested */
+	double LastUsedTime = 0.0;
+
+	/** Returns the grid coordinates for a world location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Returns true if the world XY area is fully covered by the grid */
+	bool ContainsArea(const FBox2D& Area) const;
+
+	/**
+	 *  Gets the direction to follow from the given location
+	 *  Returns false if the location is outside the grid or can't reach the goal
+	 */
+	bool SampleDirection(const FVector& Location, FVector& OutDirection) const;
+};
+
+/**
+ *  Builds and caches flow fields for large group move orders
+ *  Every unit in the group samples the same field instead of running its own path query.
+ *  Fields are shared between orders to the same area and discarded when the navmesh is rebuilt
+ */
+UCLASS()
+class UStrategyFlowFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Preferred size of each flow field cell, in world units */
+	float CellSize = 100.0f;
+
+	/** Max number of cells along each side of a field. Larger areas use bigger cells */
+	int32 MaxCellsPerSide = 128;
+
+	/** Extra space around the requested area included in the field, so units can path around obstacles */
+	float FieldMargin = 1000.0f;
+
+	/** Max vertical distance from the goal to look for the navmesh under each cell */
+	float ProjectionHeight = 500.0f;
+
+	/** Max number of fields kept in the cache */
+	int32 MaxCachedFields = 8;
+
+	/** Cached fields, most recently built last */
+	TArray<TSharedPtr<FStrategyFlowField>> CachedFields;
+
+public:
+
+	/** Hooks up navmesh rebuild notifications */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/**
+	 *  Returns a field leading to the goal that covers the given XY area
+	 *  Reuses a cached field for the same goal cell if it's large enough, otherwise builds a new one
+	 */
+	TSharedPtr<const FStrategyFlowField> FindOrBuildField(const FVector& Goal, const FBox2D& Area);
+
+	/** Discards all cached fields */
+	void InvalidateFields();
+
+protected:
+
+	/** Builds a new field leading to the goal over the given XY area */
+	TSharedPtr<FStrategyFlowField> BuildField(const FVector& Goal, const FBox2D& Area) const;
+
+	/** Called when the navmesh finishes rebuilding */
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+};
@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyGroupMove.h"
+#include "StrategyUnit.h"
+
+void FStrategyMoveOrder::ReportFinished(AStrategyUnit* Unit, bool bSuccess)
+{
+	check(NumPending > 0);
+
+	--NumPending;
+
+	if (bSuccess)
+	{
+		++NumSucceeded;
+	}
+
+	OnUnitFinished.ExecuteIfBound(*this, Unit, bSuccess);
+
+	// was this the last unit?
+	if (IsFinished())
+	{
+		OnAllFinished.ExecuteIfBound(*this);
+	}
+}
+
+void FStrategyGroupMove::Reset()
+{
+	Units.Reset();
+	Slots.Reset();
+	LeaderIndex = INDEX_NONE;
+	PathQueryId = 0;
+}
+
+int32 FStrategyFormation::GetNumColumns(int32 NumSlots)
+{
+	return FMath::Max(1, FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumSlots))));
+}
+
+void FStrategyFormation::BuildSlots(const FVector& Goal, const FVector& Direction, int32 NumSlots, float Spacing, TArray<FVector>& OutSlots)
+{
+	OutSlots.Reset(NumSlots);
+
+	// get the formation axes
+	const FVector Forward = Direction.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	const FVector Right(-Forward.Y, Forward.X, 0.0f);
+
+	const int32 NumColumns = GetNumColumns(NumSlots);
+	const int32 NumRows = FMath::DivideAndRoundUp(NumSlots, NumColumns);
+
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		// the last row may be partially filled, so center it separately
+		const int32 RowSlots = FMath::Min(NumColumns, NumSlots - Row * NumColumns);
+
+		const float Depth = ((NumRows - 1) * 0.5f - Row) * Spacing;
+
+		for (int32 Column = 0; Column < RowSlots; ++Column)
+		{
+			const float Lateral = (Column - (RowSlots - 1) * 0.5f) * Spacing;
+
+			OutSlots.Add(Goal + Forward * Depth + Right * Lateral);
+		}
+	}
+}
+
+void FStrategyFormation::AssignSlots(const TArray<TWeakObjectPtr<AStrategyUnit>>& Units, const FVector& Direction, const TArray<FVector>& Slots, TArray<FVector>& OutAssignedSlots)
+{
+	check(Units.Num() == Slots.Num());
+
+	OutAssignedSlots.SetNumUninitialized(Units.Num());
+
+	const FVector Forward = Direction.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	const FVector Right(-Forward.Y, Forward.X, 0.0f);
+
+	// sort the units front to back along the move direction
+	TArray<int32> Order;
+	Order.Reserve(Units.Num());
+
+	TArray<FVector> Locations;
+	Locations.Reserve(Units.Num());
+
+	for (int32 i = 0; i < Units.Num(); ++i)
+	{
+		Order.Add(i);
+		Locations.Add(Units[i].IsValid() ? Units[i]->GetActorLocation() : Slots[i]);
+	}
+
+	Order.Sort([&](int32 A, int32 B)
+	{
+		return (Locations[A] | Forward) > (Locations[B] | Forward);
+	});
+
+	// hand out the rows front to back. Slots are already laid out left to right within each row
+	const int32 NumColumns = GetNumColumns(Slots.Num());
+
+	for (int32 RowStart = 0; RowStart < Order.Num(); RowStart += NumColumns)
+	{
+		const int32 RowEnd = FMath::Min(RowStart + NumColumns, Order.Num());
+
+		// sort this row's units left to right
+		TArrayView<int32> RowUnits = MakeArrayView(Order).Slice(RowStart, RowEnd - RowStart);
+
+		RowUnits.Sort([&](int32 A, int32 B)
+		{
+			return (Locations[A] | Right) < (Locations[B] | Right);
+		});
+
+		for (int32 i = RowStart; i < RowEnd; ++i)
+		{
+			OutAssignedSlots[Order[i]] = Slots[i];
+		}
+	}
+}
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AStrategyUnit;
+struct FStrategyMoveOrder;
+
+/** Native callback for a unit finishing its part of a move order, successfully or not */
+DECLARE_DELEGATE_ThreeParams(FOnStrategyMoveOrderUnitFinished, const FStrategyMoveOrder& /* Order */, AStrategyUnit* /* Unit */, bool /* bSuccess */);
+
+/** Native callback for every unit in a move order having finished */
+DECLARE_DELEGATE_OneParam(FOnStrategyMoveOrderFinished, const FStrategyMoveOrder& /* Order */);
+
+/**
+ *  Tracks the completion of a move command issued to a group of units
+ *  Each unit holds a reference to the order it's carrying out and reports back to it exactly once,
+ *  when it arrives, fails, is given a new order or leaves the world
+ */
+struct FStrategyMoveOrder
+{
+	/** Unique ID of this order */
+	uint32 OrderId = 0;
+
+	/** Number of units that haven't finished yet */
+	int32 NumPending = 0;
+
+	/** Number of units that reached their goal */
+	int32 NumSucceeded = 0;
+
+	/** Called when each unit finishes */
+	FOnStrategyMoveOrderUnitFinished OnUnitFinished;
+
+	/** Called once when the last unit finishes */
+	FOnStrategyMoveOrderFinished OnAllFinished;
+
+	/** Returns true once every unit in the order has finished */
+	bool IsFinished() const { return NumPending == 0; }
+
+	/** Called by a unit when it finishes its part of the order */
+	void ReportFinished(AStrategyUnit* Unit, bool bSuccess);
+};
+
+/**
+ *  State of a group move order while its leader path is being computed
+ *  Only the leader runs a full pathfinding query. Followers reuse its path to reach their formation slots
+ */
+struct FStrategyGroupMove
+{
+	/** Units taking part in the move */
+	TArray<TWeakObjectPtr<AStrategyUnit>> Units;
+
+	/** Formation slot assigned to each unit, in the same order as Units */
+	TArray<FVector> Slots;
+
+	/** Index of the group leader in the Units array */
+	int32 LeaderIndex = INDEX_NONE;
+
+	/** ID of the pending async leader path query, or 0 if there's none */
+	uint32 PathQueryId = 0;
+
+	/** Clears the move order */
+	void Reset();
+};
+
+/**
+ *  Formation slot helpers for group move orders
+ */
+struct FStrategyFormation
+{
+	/**
+	 *  Builds a roughly square block of formation slots centered on the goal
+	 *  Rows are perpendicular to the move direction, with the first row at the front
+	 */
+	static void BuildSlots(const FVector& Goal, const FVector& Direction, int32 NumSlots, float Spacing, TArray<FVector>& OutSlots);
+
+	/**
+	 *  Assigns a slot to each unit, keeping the units' relative positions so their paths don't cross
+	 *  The front-most units take the front row, and each row is matched from left to right
+	 */
+	static void AssignSlots(const TArray<TWeakObjectPtr<AStrategyUnit>>& Units, const FVector& Direction, const TArray<FVector>& Slots, TArray<FVector>& OutAssignedSlots);
+
+	/** Returns the number of slots per row used by BuildSlots */
+	static int32 GetNumColumns(int32 NumSlots);
+};
@@ -15,12 +15,19 @@
 #include "Kismet/GameplayStatics.h"
 #include "StrategyUnit.h"
 #include "NavigationSystem.h"
-#include "Engine/OverlapResult.h"
+#include "NavigationData.h"
+#include "StrategyUnitSubsystem.h"
+#include "StrategyFlowFieldSubsystem.h"
+#include "CursorFXPoolComponent.h"
+#include "NiagaraSystem.h"
 
 AStrategyPlayerController::AStrategyPlayerController()
 {
 	// mouse cursor should always be shown
 	bShowMouseCursor = true;
+
+	// create the cursor feedback pool
+	CursorFXPool = CreateDefaultSubobject<UCursorFXPoolComponent>(TEXT("Cursor FX Pool"));
 }
 
 void AStrategyPlayerController::SetupInputComponent()
@@ -105,22 +112,60 @@ void AStrategyPlayerController::OnPossess(APawn* InPawn)
 	check(StrategyHUD);
 }
 
+void AStrategyPlayerController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// listen for units leaving the world so they can be dropped from the selection
+	if (UStrategyUnitSubsystem* UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>())
+	{
+		UnitSubsystem->OnUnitUnregistered.AddUObject(this, &AStrategyPlayerController::OnUnitUnregistered);
+	}
+}
+
+void AStrategyPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// stop listening for units leaving the world
+	if (UStrategyUnitSubsystem* UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>())
+	{
+		UnitSubsystem->OnUnitUnregistered.RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AStrategyPlayerController::DragSelectUnits(const TArray<AStrategyUnit*>& Units)
 {
 	// do we have units in the list?
 	if (Units.Num() > 0)
 	{
-		// ensure any previous units are deselected
-		DoDeselectAllCommand();
+		// only apply the difference from the current selection,
+		// so units that stay inside the box aren't notified again every frame
+		DragSelectScratch.Init(false, SelectedUnitMask.Num());
 
-		// select each new unit
-		for (AStrategyUnit* CurrentUnit : Units)
+		for (const AStrategyUnit* CurrentUnit : Units)
 		{
-			// add the unit to the selection list
-			ControlledUnits.Add(CurrentUnit);
+			if (DragSelectScratch.IsValidIndex(CurrentUnit->GetUnitIndex()))
+			{
+				DragSelectScratch[CurrentUnit->GetUnitIndex()] = true;
+			}
+		}
+
+		// deselect the units that left the box
+		for (int32 i = ControlledUnits.Num() - 1; i >= 0; --i)
+		{
+			AStrategyUnit* CurrentUnit = ControlledUnits[i];
+
+			if (!DragSelectScratch[CurrentUnit->GetUnitIndex()])
+			{
+				DeselectUnit(CurrentUnit);
+			}
+		}
 
-			// select the unit
-			CurrentUnit->UnitSelected();
+		// select the units that entered the box
+		for (AStrategyUnit* CurrentUnit : Units)
+		{
+			SelectUnit(CurrentUnit);
 		}
 
 	}
@@ -401,24 +446,13 @@ void AStrategyPlayerController::TouchSecondaryCompleted(const FInputActionValue&
 void AStrategyPlayerController::DoSelectionCommand()
 {
 
-	// do a sphere sweep to look for actors to select
-	FHitResult OutHit;
-
-	const FVector Start = CachedSelection;
-	const FVector End = Start + FVector::UpVector * 350.0f;
+	// look for the closest unit to the selection point in the unit spatial hash
+	AStrategyUnit* HitUnit = nullptr;
 
-	FCollisionShape InteractionSphere;
-	InteractionSphere.SetSphere(InteractionRadius);
-
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-	QueryParams.AddIgnoredActor(GetPawn());
-	QueryParams.bTraceComplex = true;
-
-	GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, InteractionSphere, QueryParams);
+	if (UStrategyUnitSubsystem* UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>())
+	{
+		HitUnit = UnitSubsystem->FindNearestUnit(CachedSelection, InteractionRadius);
+	}
 
 	// if we're using the mouse and are not holding the selection modifier key, deselect any units first
 	if (InputMode == SIM_Mouse && !bSelectionModifier)
@@ -428,35 +462,19 @@ void AStrategyPlayerController::DoSelectionCommand()
 	}
 
 	// did we hit a unit?
-	if (OutHit.bBlockingHit)
+	if (HitUnit)
 	{
 
 		// update the target unit
-		TargetUnit = Cast<AStrategyUnit>(OutHit.GetActor());
+		TargetUnit = HitUnit;
 
 		if (TargetUnit)
 		{
 
-			// is the unit already in the controlled list?
-			if (ControlledUnits.Contains(TargetUnit))
+			// toggle the unit's selection
+			if (!DeselectUnit(TargetUnit))
 			{
-
-				// remove the units from the controlled list
-				ControlledUnits.Remove(TargetUnit);
-
-				// tell the unit it's been deselected
-				TargetUnit->UnitDeselected();
-
-			}
-			else
-			{
-
-				// add the unit to the controlled list
-				ControlledUnits.Add(TargetUnit);
-
-				// tell the unit it's been selected
-				TargetUnit->UnitSelected();
-
+				SelectUnit(TargetUnit);
 			}
 		}
 
@@ -477,31 +495,19 @@ void AStrategyPlayerController::DoSelectionCommand()
 void AStrategyPlayerController::DoSelectAllOnScreenCommand()
 {
 
-	// find all NPCs currently on screen
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStrategyUnit::StaticClass(), FoundActors);
-
-	// process each actor found
-	for (AActor* CurrentActor : FoundActors)
+	// find all units currently on screen in the unit registry
+	if (UStrategyUnitSubsystem* UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>())
 	{
-		// cast back to our unit class
-		if (AStrategyUnit* CurrentUnit = Cast<AStrategyUnit>(CurrentActor))
+		UnitSubsystem->ForEachUnit([this](AStrategyUnit* CurrentUnit)
 		{
-			// has the actor been recently rendered?
-			if (CurrentActor->WasRecentlyRendered(0.2f))
+			// has the unit been recently rendered?
+			if (CurrentUnit->WasRecentlyRendered(0.2f))
 			{
 
-				// is the actor not on our controlled units list?
-				if (!ControlledUnits.Contains(CurrentUnit))
-				{
-					// add it to the controlled units list
-					ControlledUnits.Add(CurrentUnit);
-
-					// notify it of selection
-					CurrentUnit->UnitSelected();
-				}
+				// add it to the controlled units list if it isn't there already
+				SelectUnit(CurrentUnit);
 			}
-		}		
+		});
 	}
 
 }
@@ -522,6 +528,80 @@ void AStrategyPlayerController::DoDeselectAllCommand()
 
 	// clear the controlled units list
 	ControlledUnits.Empty();
+	SelectedUnitMask.SetRange(0, SelectedUnitMask.Num(), false);
+}
+
+bool AStrategyPlayerController::SelectUnit(AStrategyUnit* Unit)
+{
+	// only registered units can be selected
+	const int32 UnitIndex = Unit->GetUnitIndex();
+
+	if (UnitIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// grow the selection mask to fit the unit index
+	if (UnitIndex >= SelectedUnitMask.Num())
+	{
+		SelectedUnitMask.Add(false, UnitIndex + 1 - SelectedUnitMask.Num());
+	}
+
+	// is the unit already selected?
+	if (SelectedUnitMask[UnitIndex])
+	{
+		return false;
+	}
+
+	SelectedUnitMask[UnitIndex] = true;
+
+	// add the unit to the controlled list and notify it
+	ControlledUnits.Add(Unit);
+	Unit->UnitSelected();
+
+	return true;
+}
+
+bool AStrategyPlayerController::DeselectUnit(AStrategyUnit* Unit)
+{
+	// was the unit selected?
+	if (!IsUnitSelected(Unit))
+	{
+		return false;
+	}
+
+	SelectedUnitMask[Unit->GetUnitIndex()] = false;
+
+	// remove the unit from the controlled list. Selection order doesn't matter, so swap
+	ControlledUnits.RemoveSingleSwap(Unit);
+
+	// notify the unit
+	Unit->UnitDeselected();
+
+	return true;
+}
+
+bool AStrategyPlayerController::IsUnitSelected(const AStrategyUnit* Unit) const
+{
+	const int32 UnitIndex = Unit->GetUnitIndex();
+
+	return SelectedUnitMask.IsValidIndex(UnitIndex) && SelectedUnitMask[UnitIndex];
+}
+
+void AStrategyPlayerController::OnUnitUnregistered(AStrategyUnit* Unit)
+{
+	// drop the unit from the selection so its index can be safely reused
+	if (IsUnitSelected(Unit))
+	{
+		SelectedUnitMask[Unit->GetUnitIndex()] = false;
+		ControlledUnits.RemoveSingleSwap(Unit);
+	}
+
+	// clear the target unit if it's the one leaving
+	if (TargetUnit == Unit)
+	{
+		TargetUnit = nullptr;
+	}
 }
 
 void AStrategyPlayerController::DoDragScrollCommand()
@@ -582,8 +662,17 @@ void AStrategyPlayerController::DoMoveUnitsCommand()
 	// get the closest selected unit to the move goal. This will be our lead unit
 	AStrategyUnit* Closest = GetClosestSelectedUnitToLocation(CurrentMoveGoal);
 
-	// this will be set to true if any of the move requests fail
-	bool bInteractionFailed = false;
+	// start a new group move. Any pending leader path from a previous order is discarded
+	PendingGroupMove.Reset();
+
+	// start a new move order. Units still carrying out the previous one will drop it as they're reassigned
+	CurrentMoveOrder = MakeShared<FStrategyMoveOrder>();
+	CurrentMoveOrder->OrderId = ++LastMoveOrderId;
+	CurrentMoveOrder->OnUnitFinished.BindUObject(this, &AStrategyPlayerController::OnUnitMoveFinished);
+	CurrentMoveOrder->OnAllFinished.BindUObject(this, &AStrategyPlayerController::OnMoveOrderFinished);
+
+	// find the center of the group to orient the formation along the move direction
+	FVector GroupCenter = FVector::ZeroVector;
 
 	// process each unit in the controlled list
 	for (AStrategyUnit* CurrentUnit : ControlledUnits)
@@ -594,41 +683,275 @@ void AStrategyPlayerController::DoMoveUnitsCommand()
 			// stop the unit
 			CurrentUnit->StopMoving();
 
-			// move the lead unit to the goal, all other units to random navigable points around it
-			FVector MoveGoal = CurrentMoveGoal;
+			// assign the unit to the move order so it reports back when it's done
+			CurrentUnit->SetMoveOrder(CurrentMoveOrder);
 
-			if (CurrentUnit != Closest)
+			// add the unit to the group
+			if (CurrentUnit == Closest)
 			{
-
-				UNavigationSystemV1::K2_GetRandomLocationInNavigableRadius(GetWorld(), CurrentMoveGoal, MoveGoal, InteractionRadius * 0.66f);
+				PendingGroupMove.LeaderIndex = PendingGroupMove.Units.Num();
 			}
 
-			// subscribe to the unit's move completed delegate
-			CurrentUnit->OnMoveCompleted.AddDynamic(this, &AStrategyPlayerController::OnMoveCompleted);
+			PendingGroupMove.Units.Add(CurrentUnit);
+			GroupCenter += CurrentUnit->GetActorLocation();
+		}
+
+	}
+
+	if (PendingGroupMove.LeaderIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	GroupCenter /= PendingGroupMove.Units.Num();
+
+	// lay out the formation slots around the goal and hand them out to the units
+	const FVector MoveDirection = CurrentMoveGoal - GroupCenter;
+
+	TArray<FVector> FormationSlots;
+	FStrategyFormation::BuildSlots(CurrentMoveGoal, MoveDirection, PendingGroupMove.Units.Num(), FormationSpacing, FormationSlots);
+	FStrategyFormation::AssignSlots(PendingGroupMove.Units, MoveDirection, FormationSlots, PendingGroupMove.Slots);
 
-			// set up movement to the goal location
-			if (!CurrentUnit->MoveToLocation(MoveGoal, InteractionRadius * 0.66f))
+	// give the leader the slot closest to the goal so it still reaches the interaction point
+	int32 GoalSlot = 0;
+
+	for (int32 i = 1; i < PendingGroupMove.Slots.Num(); ++i)
+	{
+		if (FVector::DistSquared2D(PendingGroupMove.Slots[i], CurrentMoveGoal) < FVector::DistSquared2D(PendingGroupMove.Slots[GoalSlot], CurrentMoveGoal))
+		{
+			GoalSlot = i;
+		}
+	}
+
+	PendingGroupMove.Slots.Swap(GoalSlot, PendingGroupMove.LeaderIndex);
+
+	// snap the slots onto the navmesh. This is a cheap projection, not a path query
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		const FVector ProjectionExtent(FormationSpacing, FormationSpacing, 500.0f);
+
+		for (FVector& Slot : PendingGroupMove.Slots)
+		{
+			FNavLocation NavLocation;
+
+			if (NavSys->ProjectPointToNavigation(Slot, NavLocation, ProjectionExtent))
 			{
-				// the move request failed, so flag it
-				bInteractionFailed = true;
+				Slot = NavLocation.Location;
 			}
 		}
+	}
+
+	// large groups can share a flow field instead of following paths
+	if (bUseFlowFields && PendingGroupMove.Units.Num() >= FlowFieldMinGroupSize && MoveGroupAlongFlowField(CurrentMoveGoal))
+	{
+		PendingGroupMove.Reset();
+
+		PlayCursorFeedback(CachedInteraction, true);
+		return;
+	}
+
+	// find a single path for the leader asynchronously. The rest of the group will share it
+	AStrategyUnit* Leader = PendingGroupMove.Units[PendingGroupMove.LeaderIndex].Get();
+
+	PendingGroupMove.PathQueryId = Leader->FindPathAsync(PendingGroupMove.Slots[PendingGroupMove.LeaderIndex], FNavPathQueryDelegate::CreateUObject(this, &AStrategyPlayerController::OnGroupPathFound));
+
+	bool bInteractionFailed = false;
 
+	if (PendingGroupMove.PathQueryId == 0)
+	{
+		// we couldn't query a path for the leader, so move each unit on its own
+		bInteractionFailed = !MoveGroupIndividually();
+
+		PendingGroupMove.Reset();
 	}
 
 	// play the cursor feedback depending on whether our move succeeded or not
-	BP_CursorFeedback(CachedInteraction, !bInteractionFailed);
+	PlayCursorFeedback(CachedInteraction, !bInteractionFailed);
 
 }
 
-void AStrategyPlayerController::OnMoveCompleted(AStrategyUnit* MovedUnit)
+void AStrategyPlayerController::OnGroupPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
 {
-	// is the unit valid?
-	if (IsValid(MovedUnit))
+	// ignore results from superseded orders
+	if (QueryId != PendingGroupMove.PathQueryId)
+	{
+		return;
+	}
+
+	PendingGroupMove.PathQueryId = 0;
+
+	// ensure the leader is still around
+	AStrategyUnit* Leader = PendingGroupMove.Units[PendingGroupMove.LeaderIndex].Get();
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid() || !IsValid(Leader))
+	{
+		// no usable leader path, so fall back to individual moves
+		MoveGroupIndividually();
+		PendingGroupMove.Reset();
+		return;
+	}
+
+	const float SlotAcceptanceRadius = FormationSpacing * 0.5f;
+
+	// move the leader along its path
+	Leader->FollowPath(PendingGroupMove.Slots[PendingGroupMove.LeaderIndex], SlotAcceptanceRadius, Path);
+
+	// get the leader path's waypoints, skipping its start and end points
+	const TArray<FNavPathPoint>& LeaderPoints = Path->GetPathPoints();
+	const FVector LeaderStart = LeaderPoints.Num() > 0 ? LeaderPoints[0].Location : Leader->GetActorLocation();
+
+	// follower paths are checked and built against the same nav data and filter as the leader's
+	const ANavigationData* NavData = Path->GetNavigationDataUsed();
+	const FSharedConstNavQueryFilter QueryFilter = (Path->GetFilter().IsValid() || !NavData) ? Path->GetFilter() : NavData->GetDefaultQueryFilter();
+
+	TArray<FVector> FollowerPoints;
+
+	for (int32 i = 0; i < PendingGroupMove.Units.Num(); ++i)
+	{
+		AStrategyUnit* CurrentUnit = PendingGroupMove.Units[i].Get();
+
+		if (i == PendingGroupMove.LeaderIndex || !IsValid(CurrentUnit))
+		{
+			continue;
+		}
+
+		const FVector& Slot = PendingGroupMove.Slots[i];
+		const FVector UnitLocation = CurrentUnit->GetActorLocation();
+
+		// is this unit close enough to the leader to share its path?
+		bool bSharePath = NavData && FVector::DistSquared2D(UnitLocation, LeaderStart) <= FMath::Square(GroupPathShareRadius);
+
+		if (bSharePath)
+		{
+			// follow the leader's waypoints from our own location to our slot
+			FollowerPoints.Reset(LeaderPoints.Num());
+			FollowerPoints.Add(UnitLocation);
+
+			for (int32 PointIndex = 1; PointIndex < LeaderPoints.Num() - 1; ++PointIndex)
+			{
+				FollowerPoints.Add(LeaderPoints[PointIndex].Location);
+			}
+
+			FollowerPoints.Add(Slot);
+
+			// only the segments joining the leader's path are new. Make sure nothing blocks the way
+			// onto the first shared waypoint and from the last one to our slot
+			FVector HitLocation;
+
+			const bool bFirstBlocked = NavData->Raycast(FollowerPoints[0], FollowerPoints[1], HitLocation, QueryFilter, CurrentUnit);
+			const bool bLastBlocked = FollowerPoints.Num() > 2 && NavData->Raycast(FollowerPoints.Last(1), FollowerPoints.Last(), HitLocation, QueryFilter, CurrentUnit);
+
+			bSharePath = !bFirstBlocked && !bLastBlocked;
+		}
+
+		if (bSharePath)
+		{
+			FNavPathSharedRef FollowerPath = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(FollowerPoints);
+			FollowerPath->SetNavigationDataUsed(NavData);
+			FollowerPath->SetFilter(QueryFilter);
+
+			CurrentUnit->FollowPath(Slot, SlotAcceptanceRadius, FollowerPath);
+		}
+		else
+		{
+
+			// too far from the leader or cut off from its path, so find our own way to the slot
+			CurrentUnit->MoveToLocation(Slot, SlotAcceptanceRadius);
+		}
+	}
+
+	PendingGroupMove.Reset();
+}
+
+bool AStrategyPlayerController::MoveGroupAlongFlowField(const FVector& Goal)
+{
+	UStrategyFlowFieldSubsystem* FlowFieldSubsystem = GetWorld()->GetSubsystem<UStrategyFlowFieldSubsystem>();
+
+	if (!FlowFieldSubsystem)
+	{
+		return false;
+	}
+
+	// the field needs to cover every unit and every slot
+	FBox2D Area(ForceInit);
+
+	for (int32 i = 0; i < PendingGroupMove.Units.Num(); ++i)
+	{
+		if (const AStrategyUnit* CurrentUnit = PendingGroupMove.Units[i].Get())
+		{
+			Area += FVector2D(CurrentUnit->GetActorLocation());
+		}
+
+		Area += FVector2D(PendingGroupMove.Slots[i]);
+	}
+
+	// get a cached field for this goal, or build a new one
+	TSharedPtr<const FStrategyFlowField> Field = FlowFieldSubsystem->FindOrBuildField(Goal, Area);
+
+	if (!Field.IsValid())
+	{
+		return false;
+	}
+
+	// send every unit to its slot along the field
+	const float SlotAcceptanceRadius = FormationSpacing * 0.5f;
+
+	for (int32 i = 0; i < PendingGroupMove.Units.Num(); ++i)
+	{
+		if (AStrategyUnit* CurrentUnit = PendingGroupMove.Units[i].Get())
+		{
+			CurrentUnit->MoveAlongFlowField(Field, PendingGroupMove.Slots[i], SlotAcceptanceRadius);
+		}
+	}
+
+	return true;
+}
+
+bool AStrategyPlayerController::MoveGroupIndividually()
+{
+	const float SlotAcceptanceRadius = FormationSpacing * 0.5f;
+
+	// this will be set to true if any of the move requests fail
+	bool bMoveFailed = false;
+
+	for (int32 i = 0; i < PendingGroupMove.Units.Num(); ++i)
+	{
+		if (AStrategyUnit* CurrentUnit = PendingGroupMove.Units[i].Get())
+		{
+			if (!CurrentUnit->MoveToLocation(PendingGroupMove.Slots[i], SlotAcceptanceRadius))
+			{
+				bMoveFailed = true;
+			}
+		}
+	}
+
+	return !bMoveFailed;
+}
+
+void AStrategyPlayerController::PlayCursorFeedback(FVector Location, bool bPositive)
+{
+	// use the pooled effect if one is set up for this result
+	UNiagaraSystem* FX = bPositive ? PositiveCursorFX : NegativeCursorFX;
+	if (FX && CursorFXPool->PlayAt(FX, Location))
+	{
+		return;
+	}
+
+	// otherwise let Blueprint handle the feedback
+	BP_CursorFeedback(Location, bPositive);
+}
+
+void AStrategyPlayerController::OnUnitMoveFinished(const FStrategyMoveOrder& Order, AStrategyUnit* MovedUnit, bool bSuccess)
+{
+	// ignore superseded orders
+	if (!CurrentMoveOrder.IsValid() || Order.OrderId != CurrentMoveOrder->OrderId)
+	{
+		return;
+	}
+
+	// did the unit reach its goal?
+	if (bSuccess && IsValid(MovedUnit))
 	{
-		// unsubscribe from the delegate
-		MovedUnit->OnMoveCompleted.RemoveDynamic(this, &AStrategyPlayerController::OnMoveCompleted);
-		
 		// skip if interactions are locked
 		if (!bAllowInteraction)
 		{
@@ -642,38 +965,44 @@ void AStrategyPlayerController::OnMoveCompleted(AStrategyUnit* MovedUnit)
 		if(FVector::Dist2D(CachedInteraction, MovedUnit->GetActorLocation()) < InteractionRadius)
 		{
 
-			// do an overlap test to find nearby interactive objects
-			TArray<FOverlapResult> OutOverlaps;
-
-			FCollisionShape CollisionSphere;
-			CollisionSphere.SetSphere(InteractionRadius);
-
-			FCollisionObjectQueryParams ObjectParams;
-			ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-			
-			FCollisionQueryParams QueryParams;
-
-			QueryParams.AddIgnoredActor(MovedUnit);
+			// query the unit spatial hash for nearby units to interact with.
+			// Pad the query by the widest interaction range, then test each candidate against its own range sphere
+			TArray<AStrategyUnit*> NearbyUnits;
 
-			for(const AStrategyUnit* CurSelected : ControlledUnits)
+			if (UStrategyUnitSubsystem* UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>())
 			{
-				QueryParams.AddIgnoredActor(CurSelected);
+				UnitSubsystem->FindUnitsInRadius(CachedInteraction, InteractionRadius + UnitSubsystem->GetMaxInteractionRangeRadius(), NearbyUnits);
 			}
 
-			if (GetWorld()->OverlapMultiByObjectType(OutOverlaps, CachedInteraction, FQuat::Identity, ObjectParams, CollisionSphere, QueryParams))
+			for (AStrategyUnit* CurrentUnit : NearbyUnits)
 			{
-				for (const FOverlapResult& CurrentOverlap : OutOverlaps)
+				// skip the moved unit and any other selected units
+				if (CurrentUnit == MovedUnit || IsUnitSelected(CurrentUnit))
 				{
-					if (AStrategyUnit* CurrentUnit = Cast<AStrategyUnit>(CurrentOverlap.GetActor()))
-					{
-						CurrentUnit->Interact(MovedUnit);
-					}
+					continue;
+				}
+
+				// does the interaction sphere reach this unit's interaction range?
+				const float ReachRadius = InteractionRadius + CurrentUnit->GetInteractionRangeRadius();
+
+				if (FVector::DistSquared2D(CachedInteraction, CurrentUnit->GetActorLocation()) <= FMath::Square(ReachRadius))
+				{
+					CurrentUnit->Interact(MovedUnit);
 				}
 			}
 		}
 	}
 }
 
+void AStrategyPlayerController::OnMoveOrderFinished(const FStrategyMoveOrder& Order)
+{
+	// release the order once all its units are done
+	if (CurrentMoveOrder.IsValid() && Order.OrderId == CurrentMoveOrder->OrderId)
+	{
+		CurrentMoveOrder.Reset();
+	}
+}
+
 AStrategyUnit* AStrategyPlayerController::GetClosestSelectedUnitToLocation(FVector TargetLocation)
 {
 	// closest unit and distance
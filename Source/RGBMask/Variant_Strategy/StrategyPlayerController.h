@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "StrategyGroupMove.h"
 #include "StrategyPlayerController.generated.h"
 
 class AStrategyPawn;
@@ -13,6 +15,7 @@ struct FInputActionValue;
 class AStrategyHUD;
 class AStrategyNPC;
 class UInputAction;
+class UCursorFXPoolComponent;
 
 /** Enum to determine the last used input type */
 UENUM(BlueprintType)
@@ -32,6 +35,9 @@ class AStrategyPlayerController : public APlayerController
 {
 	GENERATED_BODY()
 
+	/** The unit registry perf test drives the select all / deselect all commands directly */
+	friend class FStrategyUnitRegistryPerfTest;
+
 protected:
 
 	/** Strategy Pawn associated with this controller */
@@ -105,10 +111,45 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm"))
 	float InteractionRadius = 250.0f;
 
+	/** Distance between formation slots when moving a group of units */
+	UPROPERTY(EditAnywhere, Category="Group Moves", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
+	float FormationSpacing = 150.0f;
+
+	/** Units within this distance of the group leader follow its path to their slot. Units farther away find their own path */
+	UPROPERTY(EditAnywhere, Category="Group Moves", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm"))
+	float GroupPathShareRadius = 1000.0f;
+
+	/**
+	 *  If true, large groups steer along a shared flow field instead of following navmesh paths
+	 *  Building a field is synchronous: it projects every cell onto the navmesh on the frame the order is given
+	 */
+	UPROPERTY(EditAnywhere, Category="Group Moves")
+	bool bUseFlowFields = false;
+
+	/**
+	 *  Minimum number of units in a move order to use a flow field
+	 *  A new field costs up to 128x128 navmesh point projections on the click frame, so keep this high enough
+	 *  that the field replaces enough path queries to pay for itself. Cached fields for the same goal are reused
+	 */
+	UPROPERTY(EditAnywhere, Category="Group Moves", meta = (ClampMin = 1, ClampMax = 1000, EditCondition = "bUseFlowFields"))
+	int32 FlowFieldMinGroupSize = 16;
+
 	/** Max distance between the starting and current position of the second touch finger to be considered a box selection */
 	UPROPERTY(EditAnywhere, Category="Input", meta = (ClampMin = 0, ClampMax = 10000))
 	float MinSecondFingerDistanceForBoxSelect = 10.0f;
 
+	/** Cursor effect for a successful interaction. If unset, BP_CursorFeedback is called instead */
+	UPROPERTY(EditAnywhere, Category="Cursor")
+	TObjectPtr<UNiagaraSystem> PositiveCursorFX;
+
+	/** Cursor effect for a failed interaction. If unset, BP_CursorFeedback is called instead */
+	UPROPERTY(EditAnywhere, Category="Cursor")
+	TObjectPtr<UNiagaraSystem> NegativeCursorFX;
+
+	/** Pooled Niagara components used to play the cursor effects without spawning new ones */
+	UPROPERTY(VisibleDefaultsOnly, Category="Cursor")
+	TObjectPtr<UCursorFXPoolComponent> CursorFXPool;
+
 	/** Saves the world location of the last initiated interaction */
 	FVector CachedInteraction;
 
@@ -159,9 +200,24 @@ protected:
 	/** Currently selected unit */
 	AStrategyUnit* TargetUnit = nullptr;
 
+	/** Group move order waiting on its leader path */
+	FStrategyGroupMove PendingGroupMove;
+
+	/** Latest move order issued to the selected units */
+	TSharedPtr<FStrategyMoveOrder> CurrentMoveOrder;
+
+	/** ID of the last move order issued */
+	uint32 LastMoveOrderId = 0;
+
 	/** Currently selected unit list */
 	TArray<AStrategyUnit*> ControlledUnits;
 
+	/** Selection flag for each unit, indexed by unit index */
+	TBitArray<> SelectedUnitMask;
+
+	/** Flags the units in the drag select box, indexed by unit index. Reused between updates */
+	TBitArray<> DragSelectScratch;
+
 	///////////////////////////////////
 	// Touchscreen enhanced input workaround
 
@@ -196,6 +252,14 @@ public:
 	/** Pawn initialization */
 	virtual void OnPossess(APawn* InPawn);
 
+protected:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Gameplay cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 
 	/** Updates selected units from the HUD's drag select box */
@@ -269,15 +333,38 @@ protected:
 	/** Deselect all controlled units */
 	void DoDeselectAllCommand();
 
+	/** Adds a unit to the selection and notifies it. Returns false if it was already selected */
+	bool SelectUnit(AStrategyUnit* Unit);
+
+	/** Removes a unit from the selection and notifies it. Returns false if it wasn't selected */
+	bool DeselectUnit(AStrategyUnit* Unit);
+
+	/** Returns true if the unit is currently selected */
+	bool IsUnitSelected(const AStrategyUnit* Unit) const;
+
+	/** Drops a unit that's leaving the world from the selection */
+	void OnUnitUnregistered(AStrategyUnit* Unit);
+
 	/** Drag scroll the camera */
 	void DoDragScrollCommand();
 
 	/** Move all selected units */
 	void DoMoveUnitsCommand();
 
-	/** Called when a unit move is completed */
-	UFUNCTION()
-	void OnMoveCompleted(AStrategyUnit* MovedUnit);
+	/** Called when the leader path for a group move has been found */
+	void OnGroupPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	/** Sends every unit in the pending group move to its slot along a shared flow field. Returns false if no field could be built */
+	bool MoveGroupAlongFlowField(const FVector& Goal);
+
+	/** Moves every unit in the pending group move to its slot with its own pathfinding request. Returns false if any move failed */
+	bool MoveGroupIndividually();
+
+	/** Called when a unit finishes its part of a move order */
+	void OnUnitMoveFinished(const FStrategyMoveOrder& Order, AStrategyUnit* MovedUnit, bool bSuccess);
+
+	/** Called when every unit in a move order has finished */
+	void OnMoveOrderFinished(const FStrategyMoveOrder& Order);
 
 	/** Sorts all controlled units based on their distance to the provided world location */
 	AStrategyUnit* GetClosestSelectedUnitToLocation(FVector TargetLocation);
@@ -295,6 +382,9 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Cursor", meta = (DisplayName="Cursor Feedback"))
 	void BP_CursorFeedback(FVector Location, bool bPositive);
 
+	/** Plays the pooled cursor feedback if its FX are set, otherwise falls back to BP_CursorFeedback */
+	void PlayCursorFeedback(FVector Location, bool bPositive);
+
 	/** Resets the interaction flag */
 	void ResetInteraction();
 
@@ -7,6 +7,11 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Components/SphereComponent.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "StrategyUnitSubsystem.h"
+#include "StrategyFlowFieldSubsystem.h"
+#include "StrategyGroupMove.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
 
 AStrategyUnit::AStrategyUnit()
 {
@@ -39,8 +44,56 @@ AStrategyUnit::AStrategyUnit()
 	GetCharacterMovement()->SetFixedBrakingDistance(true);
 }
 
+void AStrategyUnit::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// register with the unit subsystem so we can be found by selection and interaction queries
+	UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>();
+
+	if (UnitSubsystem)
+	{
+		UnitSubsystem->RegisterUnit(this);
+
+		// update our spatial hash cell whenever we move
+		GetRootComponent()->TransformUpdated.AddUObject(this, &AStrategyUnit::OnUnitTransformUpdated);
+	}
+}
+
+void AStrategyUnit::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// we won't finish our current move order
+	ReportMoveOrderFinished(false);
+
+	// unregister from the unit subsystem
+	if (UnitSubsystem)
+	{
+		GetRootComponent()->TransformUpdated.RemoveAll(this);
+
+		UnitSubsystem->UnregisterUnit(this);
+		UnitSubsystem = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AStrategyUnit::OnUnitTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UnitSubsystem->UpdateUnitLocation(this, UpdatedComponent->GetComponentLocation());
+}
+
 void AStrategyUnit::NotifyControllerChanged()
 {
+	// unsubscribe from the previous controller's path following component
+	if (UPathFollowingComponent* OldPFComp = BoundPathFollowingComponent.Get())
+	{
+		OldPFComp->OnRequestFinished.Remove(MoveFinishedHandle);
+	}
+
+	BoundPathFollowingComponent.Reset();
+	MoveFinishedHandle.Reset();
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
 	// validate and save a copy of the AI controller reference
 	AIController = Cast<AAIController>(Controller);
 	
@@ -50,13 +103,83 @@ void AStrategyUnit::NotifyControllerChanged()
 		UPathFollowingComponent* PFComp = AIController->GetPathFollowingComponent();
 		if (PFComp)
 		{
-			PFComp->OnRequestFinished.AddUObject(this, &AStrategyUnit::OnMoveFinished);
+			MoveFinishedHandle = PFComp->OnRequestFinished.AddUObject(this, &AStrategyUnit::OnMoveFinished);
+			BoundPathFollowingComponent = PFComp;
 		}
 	}
 }
 
+void AStrategyUnit::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// are we following a flow field?
+	if (!FlowField.IsValid())
+	{
+		return;
+	}
+
+	const FVector ToGoal = FlowFieldGoal - GetActorLocation();
+	const float GoalDistance = ToGoal.Size2D();
+
+	// have we arrived?
+	if (GoalDistance <= FlowFieldAcceptanceRadius)
+	{
+		FlowField.Reset();
+
+		// report the move as completed
+		ReportMoveOrderFinished(true);
+		OnMoveCompleted.Broadcast(this);
+		return;
+	}
+
+	// are we still getting closer to the goal?
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (GoalDistance < FlowFieldBestDistance - FlowFieldMinProgress)
+	{
+		FlowFieldBestDistance = GoalDistance;
+		FlowFieldLastProgressTime = CurrentTime;
+	}
+	else if (CurrentTime - FlowFieldLastProgressTime > FlowFieldStuckTime)
+	{
+		// we're stuck against other units or geometry the field doesn't know about, so fall back to regular pathfinding
+		MoveToLocation(FlowFieldGoal, FlowFieldAcceptanceRadius);
+		return;
+	}
+
+	// sample the field at our location
+	FVector Direction;
+
+	if (!FlowField->SampleDirection(GetActorLocation(), Direction))
+	{
+		// we left the field or can't reach its goal, so fall back to regular pathfinding
+		MoveToLocation(FlowFieldGoal, FlowFieldAcceptanceRadius);
+		return;
+	}
+
+	// once we're near our own goal, or the field has run out, head straight for it
+	if (Direction.IsNearlyZero() || ToGoal.SizeSquared2D() <= FMath::Square(FlowField->CellSize * 2.0f))
+	{
+		Direction = ToGoal.GetSafeNormal2D();
+	}
+
+	AddMovementInput(Direction);
+}
+
 void AStrategyUnit::StopMoving()
 {
+	// stop following any flow field
+	FlowField.Reset();
+
+	// stop any path following move. Ignore the result of the request this aborts
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
+	if (AIController)
+	{
+		AIController->StopMovement();
+	}
+
 	// use the character movement component to stop movement
 	GetCharacterMovement()->StopMovementImmediately();
 }
@@ -90,8 +213,33 @@ void AStrategyUnit::Interact(AStrategyUnit* Interactor)
 	
 }
 
+float AStrategyUnit::GetInteractionRangeRadius() const
+{
+	return InteractionRange->GetScaledSphereRadius();
+}
+
+void AStrategyUnit::SetMoveOrder(const TSharedPtr<FStrategyMoveOrder>& Order)
+{
+	// the previous order won't be finished by us, so stop tracking its request
+	ReportMoveOrderFinished(false);
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
+	MoveOrder = Order;
+
+	if (MoveOrder.IsValid())
+	{
+		++MoveOrder->NumPending;
+	}
+}
+
 bool AStrategyUnit::MoveToLocation(const FVector& Location, float AcceptanceRadius)
 {
+	// stop following any flow field
+	FlowField.Reset();
+
+	// ignore the results of any request this move aborts
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
 	// ensure we have a valid AI Controller
 	if (AIController)
 	{
@@ -117,30 +265,137 @@ bool AStrategyUnit::MoveToLocation(const FVector& Location, float AcceptanceRadi
 			// failed. Return false
 			case EPathFollowingRequestResult::Failed:
 
+				ReportMoveOrderFinished(false);
 				return false;
 				break;
 
 			// already at goal. Return true and call the move completed delegate
 			case EPathFollowingRequestResult::AlreadyAtGoal:
 
+				ReportMoveOrderFinished(true);
 				OnMoveCompleted.Broadcast(this);
 				return true;
 				break;
 
-			// move successfully scheduled. Return true
+			// move successfully scheduled. Save the request ID and return true
 			case EPathFollowingRequestResult::RequestSuccessful:
 
+				MoveRequestId = ResultData.MoveId;
 				return true;
 				break;
 		}
 	}
 
 	// the move could not be completed
+	ReportMoveOrderFinished(false);
+	return false;
+}
+
+bool AStrategyUnit::FollowPath(const FVector& Location, float AcceptanceRadius, FNavPathSharedPtr Path)
+{
+	// stop following any flow field
+	FlowField.Reset();
+
+	// ignore the results of any request this move aborts
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
+	// ensure we have a valid AI Controller and path
+	if (AIController && Path.IsValid())
+	{
+		// set up the AI Move Request. The path has already been found, so no pathfinding is needed
+		FAIMoveRequest MoveReq;
+
+		MoveReq.SetGoalLocation(Location);
+		MoveReq.SetAcceptanceRadius(AcceptanceRadius);
+		MoveReq.SetAllowPartialPath(true);
+		MoveReq.SetUsePathfinding(true);
+		MoveReq.SetCanStrafe(false);
+
+		// hand the path to the path following component
+		MoveRequestId = AIController->RequestMove(MoveReq, Path);
+
+		if (MoveRequestId.IsValid())
+		{
+			return true;
+		}
+	}
+
+	// the move could not be started
+	ReportMoveOrderFinished(false);
 	return false;
 }
 
+void AStrategyUnit::MoveAlongFlowField(TSharedPtr<const FStrategyFlowField> Field, const FVector& Location, float AcceptanceRadius)
+{
+	// stop any path following move, we'll steer ourselves from Tick.
+	// Ignore the result of the request this aborts
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
+	if (AIController)
+	{
+		AIController->StopMovement();
+	}
+
+	FlowField = Field;
+	FlowFieldGoal = Location;
+	FlowFieldAcceptanceRadius = AcceptanceRadius;
+
+	// start tracking our progress towards the goal
+	FlowFieldBestDistance = FVector::Dist2D(GetActorLocation(), Location);
+	FlowFieldLastProgressTime = GetWorld()->GetTimeSeconds();
+}
+
+uint32 AStrategyUnit::FindPathAsync(const FVector& Location, const FNavPathQueryDelegate& ResultDelegate) const
+{
+	// ensure we have a valid AI Controller and navigation system
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!AIController || !NavSys)
+	{
+		return 0;
+	}
+
+	// find the navigation data for our agent
+	const FNavAgentProperties& AgentProperties = GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProperties, GetNavAgentLocation());
+
+	if (!NavData)
+	{
+		return 0;
+	}
+
+	// use the same filter as our regular move requests
+	FSharedConstNavQueryFilter QueryFilter = UNavigationQueryFilter::GetQueryFilter(*NavData, AIController, AIController->GetDefaultNavigationFilterClass());
+
+	FPathFindingQuery Query(AIController, *NavData, GetNavAgentLocation(), Location, QueryFilter);
+	Query.SetAllowPartialPaths(true);
+
+	// schedule the query on the navigation system
+	return NavSys->FindPathAsync(AgentProperties, Query, ResultDelegate);
+}
+
 void AStrategyUnit::OnMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result)
 {
-	// call the delegate
+	// ignore results for requests other than our current move, such as the ones aborted by a new move
+	if (RequestID != MoveRequestId)
+	{
+		return;
+	}
+
+	MoveRequestId = FAIRequestID::InvalidRequest;
+
+	// report to our move order and call the delegate
+	ReportMoveOrderFinished(Result.IsSuccess());
 	OnMoveCompleted.Broadcast(this);
 }
+
+void AStrategyUnit::ReportMoveOrderFinished(bool bSuccess)
+{
+	if (MoveOrder.IsValid())
+	{
+		// clear the order first, in case the callback issues a new one
+		TSharedPtr<FStrategyMoveOrder> FinishedOrder = MoveTemp(MoveOrder);
+
+		FinishedOrder->ReportFinished(this, bSuccess);
+	}
+}
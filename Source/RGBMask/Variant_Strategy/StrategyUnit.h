@@ -5,9 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AIController.h"
+#include "NavigationData.h"
 #include "StrategyUnit.generated.h"
 
 class USphereComponent;
+class UPathFollowingComponent;
+class UStrategyUnitSubsystem;
+struct FStrategyFlowField;
+struct FStrategyMoveOrder;
 
 /** Delegate to report that this unit has finished moving */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUnitMoveCompletedDelegate, AStrategyUnit*, Unit);
@@ -32,6 +37,49 @@ protected:
 	/** Cast reference to the AI Controlling this unit */
 	TObjectPtr<AAIController> AIController;
 
+	/** Unit subsystem this unit is registered with */
+	TObjectPtr<UStrategyUnitSubsystem> UnitSubsystem;
+
+	/** Move order this unit is carrying out, if any */
+	TSharedPtr<FStrategyMoveOrder> MoveOrder;
+
+	/** ID of the path following request for the current move. Results for other requests are ignored */
+	FAIRequestID MoveRequestId = FAIRequestID::InvalidRequest;
+
+	/** Path following component we're subscribed to */
+	TWeakObjectPtr<UPathFollowingComponent> BoundPathFollowingComponent;
+
+	/** Handle for our path following request finished subscription */
+	FDelegateHandle MoveFinishedHandle;
+
+	/** Flow field this unit is currently following, if any */
+	TSharedPtr<const FStrategyFlowField> FlowField;
+
+	/** Final location of the current flow field move */
+	FVector FlowFieldGoal;
+
+	/** Acceptance radius of the current flow field move */
+	float FlowFieldAcceptanceRadius = 0.0f;
+
+	/** Closest 2D distance to the flow field goal reached so far in the current move */
+	float FlowFieldBestDistance = 0.0f;
+
+	/** Game time when we last got meaningfully closer to the flow field goal */
+	float FlowFieldLastProgressTime = 0.0f;
+
+	/** If a flow field move doesn't get us closer to the goal for this long, fall back to regular pathfinding */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 0.1, ClampMax = 10, Units="s"))
+	float FlowFieldStuckTime = 1.5f;
+
+	/** Distance we need to gain on the flow field goal for it to count as progress */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 0, ClampMax = 500, Units="cm"))
+	float FlowFieldMinProgress = 25.0f;
+
+	/** Index assigned by the unit subsystem while registered */
+	int32 UnitIndex = INDEX_NONE;
+
+	friend class UStrategyUnitSubsystem;
+
 public:
 
 	/** Constructor */
@@ -39,8 +87,24 @@ public:
 
 protected:
 
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Gameplay cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void NotifyControllerChanged() override;
 
+public:
+
+	/** Steers along the active flow field, if any */
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+
+	/** Keeps this unit's spatial hash cell up to date as it moves */
+	void OnUnitTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
 public:
 
 	/** Stops unit movement immediately */
@@ -55,14 +119,35 @@ public:
 	/** Notifies this unit that it's been interacted with by another actor */
 	void Interact(AStrategyUnit* Interactor);
 
+	/** Returns the index assigned by the unit subsystem, or INDEX_NONE if not registered */
+	int32 GetUnitIndex() const { return UnitIndex; }
+
+	/** Returns the radius of this unit's interaction range sphere */
+	float GetInteractionRangeRadius() const;
+
+	/** Assigns the move order this unit's next move belongs to. Any previous order is reported as failed */
+	void SetMoveOrder(const TSharedPtr<FStrategyMoveOrder>& Order);
+
 	/** Attempts to move this unit to its */
 	bool MoveToLocation(const FVector& Location, float AcceptanceRadius);
 
+	/** Attempts to move this unit to the location following an already computed path */
+	bool FollowPath(const FVector& Location, float AcceptanceRadius, FNavPathSharedPtr Path);
+
+	/** Moves this unit to the location by steering along a shared flow field instead of following its own path */
+	void MoveAlongFlowField(TSharedPtr<const FStrategyFlowField> Field, const FVector& Location, float AcceptanceRadius);
+
+	/** Starts an async pathfinding query from this unit to the location. Returns the query ID, or 0 if it couldn't be started */
+	uint32 FindPathAsync(const FVector& Location, const FNavPathQueryDelegate& ResultDelegate) const;
+
 protected:
 
 	/** called by the AI controller when this unit has finished moving */
 	void OnMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result);
 
+	/** Reports the end of the current move to its move order, if any */
+	void ReportMoveOrderFinished(bool bSuccess);
+
 protected:
 
 	/** Blueprint handler for strategy game selection */
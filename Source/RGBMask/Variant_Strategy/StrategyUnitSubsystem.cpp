@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyUnitSubsystem.h"
+#include "StrategyUnit.h"
+
+template<typename VisitorType>
+void UStrategyUnitSubsystem::ForEachUnitInCells(const FVector& Location, float Radius, VisitorType&& Visitor) const
+{
+	// find the range of cells overlapped by the circle's bounding square
+	const FIntPoint MinCell = GetCellCoord(Location - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxCell = GetCellCoord(Location + FVector(Radius, Radius, 0.0f));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			if (const TArray<AStrategyUnit*>* CellUnits = Cells.Find(FIntPoint(X, Y)))
+			{
+				for (AStrategyUnit* CurrentUnit : *CellUnits)
+				{
+					Visitor(CurrentUnit);
+				}
+			}
+		}
+	}
+}
+
+void UStrategyUnitSubsystem::RegisterUnit(AStrategyUnit* Unit)
+{
+	// ignore invalid or already registered units
+	if (!IsValid(Unit) || Unit->UnitIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCellCoord(Unit->GetActorLocation());
+
+	// reuse a free index if we have one, otherwise grow the unit array
+	if (FreeIndices.Num() > 0)
+	{
+		Unit->UnitIndex = FreeIndices.Pop(EAllowShrinking::No);
+
+		Units[Unit->UnitIndex] = Unit;
+		UnitCells[Unit->UnitIndex] = Cell;
+	}
+	else
+	{
+		Unit->UnitIndex = Units.Add(Unit);
+		UnitCells.Add(Cell);
+	}
+
+	AddToCell(Unit, Cell);
+
+	// keep track of the widest interaction range so range queries can be padded by it
+	MaxInteractionRangeRadius = FMath::Max(MaxInteractionRangeRadius, Unit->GetInteractionRangeRadius());
+}
+
+void UStrategyUnitSubsystem::UnregisterUnit(AStrategyUnit* Unit)
+{
+	// ignore units that aren't registered
+	if (!Unit || !Units.IsValidIndex(Unit->UnitIndex) || Units[Unit->UnitIndex] != Unit)
+	{
+		return;
+	}
+
+	// let listeners drop any per-unit state while the index is still valid
+	OnUnitUnregistered.Broadcast(Unit);
+
+	RemoveFromCell(Unit, UnitCells[Unit->UnitIndex]);
+
+	// free the unit's slot
+	Units[Unit->UnitIndex] = nullptr;
+	FreeIndices.Add(Unit->UnitIndex);
+
+	Unit->UnitIndex = INDEX_NONE;
+}
+
+void UStrategyUnitSubsystem::UpdateUnitLocation(AStrategyUnit* Unit, const FVector& Location)
+{
+	// skip unregistered units
+	if (Unit->UnitIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// only rehash when the unit crosses into a different cell
+	FIntPoint& CurrentCell = UnitCells[Unit->UnitIndex];
+	const FIntPoint NewCell = GetCellCoord(Location);
+
+	if (NewCell != CurrentCell)
+	{
+		RemoveFromCell(Unit, CurrentCell);
+		AddToCell(Unit, NewCell);
+
+		CurrentCell = NewCell;
+	}
+}
+
+AStrategyUnit* UStrategyUnitSubsystem::FindNearestUnit(const FVector& Location, float Radius) const
+{
+	AStrategyUnit* OutUnit = nullptr;
+	float Closest = FMath::Square(Radius);
+
+	ForEachUnitInCells(Location, Radius, [&](AStrategyUnit* CurrentUnit)
+	{
+		// is this unit closer than the best so far?
+		const float Dist = FVector::DistSquared2D(Location, CurrentUnit->GetActorLocation());
+
+		if (Dist <= Closest)
+		{
+			OutUnit = CurrentUnit;
+			Closest = Dist;
+		}
+	});
+
+	return OutUnit;
+}
+
+void UStrategyUnitSubsystem::FindUnitsInRadius(const FVector& Location, float Radius, TArray<AStrategyUnit*>& OutUnits) const
+{
+	const float RadiusSquared = FMath::Square(Radius);
+
+	ForEachUnitInCells(Location, Radius, [&](AStrategyUnit* CurrentUnit)
+	{
+		if (FVector::DistSquared2D(Location, CurrentUnit->GetActorLocation()) <= RadiusSquared)
+		{
+			OutUnits.Add(CurrentUnit);
+		}
+	});
+}
+
+void UStrategyUnitSubsystem::SetCellSize(float InCellSize)
+{
+	InCellSize = FMath::Max(InCellSize, 100.0f);
+
+	if (FMath::IsNearlyEqual(InCellSize, CellSize))
+	{
+		return;
+	}
+
+	CellSize = InCellSize;
+
+	// rehash every registered unit with the new cell size
+	Cells.Reset();
+
+	for (int32 i = 0; i < Units.Num(); ++i)
+	{
+		if (Units[i])
+		{
+			UnitCells[i] = GetCellCoord(Units[i]->GetActorLocation());
+			AddToCell(Units[i], UnitCells[i]);
+		}
+	}
+}
+
+FIntPoint UStrategyUnitSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UStrategyUnitSubsystem::AddToCell(AStrategyUnit* Unit, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Unit);
+}
+
+void UStrategyUnitSubsystem::RemoveFromCell(AStrategyUnit* Unit, const FIntPoint& Cell)
+{
+	if (TArray<AStrategyUnit*>* CellUnits = Cells.Find(Cell))
+	{
+		CellUnits->RemoveSingleSwap(Unit);
+
+		if (CellUnits->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
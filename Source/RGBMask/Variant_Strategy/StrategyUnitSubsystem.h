@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrategyUnitSubsystem.generated.h"
+
+class AStrategyUnit;
+
+/** Delegate to report that a unit is about to be removed from the registry */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnStrategyUnitUnregistered, AStrategyUnit* /* Unit */);
+
+/**
+ *  Keeps track of all strategy units in the world
+ *  Each unit gets a stable index into a dense unit array, so other systems can keep per-unit
+ *  state in flat arrays or bit arrays. Indices of removed units are reused by new ones.
+ *  Units are also bucketed into a 2D spatial hash on the XY plane so selection and interaction
+ *  queries only test the units in nearby cells, without touching the physics scene
+ */
+UCLASS()
+class UStrategyUnitSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Size of each spatial hash cell, in world units */
+	float CellSize = 500.0f;
+
+	/** Units in each occupied cell */
+	TMap<FIntPoint, TArray<AStrategyUnit*>> Cells;
+
+	/** Registered units, indexed by unit index. Free slots are null */
+	TArray<AStrategyUnit*> Units;
+
+	/** Cell each registered unit was last hashed into, indexed by unit index */
+	TArray<FIntPoint> UnitCells;
+
+	/** Unit indices freed by unregistered units, to be reused */
+	TArray<int32> FreeIndices;
+
+	/** Largest interaction range radius of any unit registered so far. Never shrinks */
+	float MaxInteractionRangeRadius = 0.0f;
+
+public:
+
+	/** Called before a unit is unregistered, while its unit index is still valid */
+	FOnStrategyUnitUnregistered OnUnitUnregistered;
+
+public:
+
+	/** Adds a unit to the spatial hash */
+	void RegisterUnit(AStrategyUnit* Unit);
+
+	/** Removes a unit from the spatial hash */
+	void UnregisterUnit(AStrategyUnit* Unit);
+
+	/** Moves a unit to a new cell if its location crossed a cell boundary */
+	void UpdateUnitLocation(AStrategyUnit* Unit, const FVector& Location);
+
+	/** Returns the unit closest to the location within the given 2D radius, or nullptr if there are none */
+	AStrategyUnit* FindNearestUnit(const FVector& Location, float Radius) const;
+
+	/** Adds all units within the given 2D radius of the location to the output array */
+	void FindUnitsInRadius(const FVector& Location, float Radius, TArray<AStrategyUnit*>& OutUnits) const;
+
+	/** Calls the visitor for every registered unit */
+	template<typename VisitorType>
+	void ForEachUnit(VisitorType&& Visitor) const
+	{
+		for (AStrategyUnit* CurrentUnit : Units)
+		{
+			if (CurrentUnit)
+			{
+				Visitor(CurrentUnit);
+			}
+		}
+	}
+
+	/** Returns the number of registered units */
+	int32 GetNumUnits() const { return Units.Num() - FreeIndices.Num(); }
+
+	/** Returns the upper bound for unit indices. Use it to size per-unit arrays */
+	int32 GetMaxUnitIndex() const { return Units.Num(); }
+
+	/** Returns the unit registered at the given index, or nullptr */
+	AStrategyUnit* GetUnit(int32 UnitIndex) const { return Units.IsValidIndex(UnitIndex) ? Units[UnitIndex] : nullptr; }
+
+	/** Changes the cell size and rehashes all registered units */
+	void SetCellSize(float InCellSize);
+
+	/** Returns the spatial hash cell size */
+	float GetCellSize() const { return CellSize; }
+
+	/** Returns an upper bound for the interaction range radius of registered units. Use it to pad range queries */
+	float GetMaxInteractionRangeRadius() const { return MaxInteractionRangeRadius; }
+
+protected:
+
+	/** Returns the cell coordinates for a world location */
+	FIntPoint GetCellCoord(const FVector& Location) const;
+
+	/** Adds a unit to a cell */
+	void AddToCell(AStrategyUnit* Unit, const FIntPoint& Cell);
+
+	/** Removes a unit from a cell, discarding the cell if it's left empty */
+	void RemoveFromCell(AStrategyUnit* Unit, const FIntPoint& Cell);
+
+	/** Calls the visitor for each unit in the cells overlapping the circle */
+	template<typename VisitorType>
+	void ForEachUnitInCells(const FVector& Location, float Radius, VisitorType&& Visitor) const;
+};
@@ -3,8 +3,12 @@
 
 #include "StrategyHUD.h"
 #include "StrategyUnit.h"
+#include "StrategyUnitSubsystem.h"
 #include "StrategyPlayerController.h"
 #include "StrategyUI.h"
+#include "CanvasItem.h"
+#include "Engine/Canvas.h"
+#include "RenderUtils.h"
 
 void AStrategyHUD::BeginPlay()
 {
@@ -42,36 +46,112 @@ void AStrategyHUD::DrawHUD()
 			DrawRect(SelectionBoxColor, BoxStart.X, BoxStart.Y, BoxSize.X, BoxSize.Y);
 
 			// get all the units in the selection box
-			TArray<AStrategyUnit*> BoxedUnits;
-			GetActorsInSelectionRectangle(BoxStart, BoxCurrentPosition, BoxedUnits, true);
+			BoxedUnits.Reset();
+			GetUnitsInSelectionBox(BoxedUnits);
 
 			// update the unit selection on the player controller
 			PC->DragSelectUnits(BoxedUnits);
 		}
 
 		// get the currently selected units
-		TArray<AStrategyUnit*> SelectedUnits = PC->GetSelectedUnits();
+		const TArray<AStrategyUnit*>& SelectedUnits = PC->GetSelectedUnits();
 
 		// update the selection count on the UI widget
 		UIWidget->SetSelectedUnitsCount(SelectedUnits.Num());
 
-		// process each selected unit
-		for (AStrategyUnit* CurrentUnit : SelectedUnits)
+		// mark each selected unit
+		DrawSelectionMarkers(SelectedUnits);
+	}
+
+}
+
+void AStrategyHUD::DrawSelectionMarkers(const TArray<AStrategyUnit*>& SelectedUnits)
+{
+	if (SelectedUnits.Num() == 0 || !Canvas)
+	{
+		return;
+	}
+
+	SelectionMarkerTriangles.Reset(SelectedUnits.Num() * 2);
+
+	// add a diamond made of two triangles under each selected unit
+	for (const AStrategyUnit* CurrentUnit : SelectedUnits)
+	{
+		if (IsValid(CurrentUnit))
 		{
-			if (IsValid(CurrentUnit))
+			// project the unit's location to screen coordinates
+			const FVector ScreenLocation = Project(CurrentUnit->GetActorLocation(), true);
+
+			// units behind the camera project with mirrored coordinates, skip them
+			if (ScreenLocation.Z <= 0.0f)
 			{
-				// project the unit's location to screen coordinates
-				FVector2D ScreenCoords;
-
-				if (PC->ProjectWorldLocationToScreen(CurrentUnit->GetActorLocation(), ScreenCoords, true))
-				{
-					// draw a selection string near the unit
-					const FString SelectionString = "Selected";
-					DrawText(SelectionString, FColor::White, ScreenCoords.X - 25.0f, ScreenCoords.Y + 25.0f, nullptr, 1.5f);
-				}
+				continue;
 			}
-			
+
+			const FVector2D Center(ScreenLocation.X, ScreenLocation.Y + SelectionMarkerOffset);
+
+			const FVector2D Top = Center - FVector2D(0.0f, SelectionMarkerSize);
+			const FVector2D Bottom = Center + FVector2D(0.0f, SelectionMarkerSize);
+			const FVector2D Left = Center - FVector2D(SelectionMarkerSize, 0.0f);
+			const FVector2D Right = Center + FVector2D(SelectionMarkerSize, 0.0f);
+
+			FCanvasUVTri& UpperTri = SelectionMarkerTriangles.AddDefaulted_GetRef();
+			UpperTri.V0_Pos = Left;
+			UpperTri.V1_Pos = Top;
+			UpperTri.V2_Pos = Right;
+			UpperTri.V0_Color = UpperTri.V1_Color = UpperTri.V2_Color = SelectionMarkerColor;
+
+			FCanvasUVTri& LowerTri = SelectionMarkerTriangles.AddDefaulted_GetRef();
+			LowerTri.V0_Pos = Left;
+			LowerTri.V1_Pos = Right;
+			LowerTri.V2_Pos = Bottom;
+			LowerTri.V0_Color = LowerTri.V1_Color = LowerTri.V2_Color = SelectionMarkerColor;
 		}
 	}
 
+	// nothing visible to draw?
+	if (SelectionMarkerTriangles.Num() == 0)
+	{
+		return;
+	}
+
+	// draw all the markers in one batch
+	FCanvasTriangleItem MarkerItem(SelectionMarkerTriangles, GWhiteTexture);
+	MarkerItem.BlendMode = SE_BLEND_Translucent;
+
+	Canvas->DrawItem(MarkerItem);
+}
+
+void AStrategyHUD::GetUnitsInSelectionBox(TArray<AStrategyUnit*>& OutUnits) const
+{
+	UStrategyUnitSubsystem* UnitSubsystem = GetWorld()->GetSubsystem<UStrategyUnitSubsystem>();
+
+	if (!UnitSubsystem || !Canvas)
+	{
+		return;
+	}
+
+	// get the padded selection rectangle. The box may have been dragged in any direction
+	const FVector2D Padding(SelectionBoxPadding, SelectionBoxPadding);
+	const FBox2D SelectionBox(
+		FVector2D::Min(BoxStart, BoxCurrentPosition) - Padding,
+		FVector2D::Max(BoxStart, BoxCurrentPosition) + Padding);
+
+	// project each unit's location once and test it against the box.
+	// This avoids the per-actor bounds projection of GetActorsInSelectionRectangle
+	UnitSubsystem->ForEachUnit([&](AStrategyUnit* CurrentUnit)
+	{
+		const FVector ScreenLocation = Project(CurrentUnit->GetActorLocation(), true);
+
+		// units behind the camera project with mirrored coordinates, skip them
+		if (ScreenLocation.Z <= 0.0f)
+		{
+			return;
+		}
+
+		if (SelectionBox.IsInside(FVector2D(ScreenLocation.X, ScreenLocation.Y)))
+		{
+			OutUnits.Add(CurrentUnit);
+		}
+	});
 }
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
+#include "CanvasTypes.h"
 #include "StrategyHUD.generated.h"
 
 class UStrategyUI;
+class AStrategyUnit;
 
 /**
  *  Simple strategy game HUD
@@ -43,6 +45,28 @@ protected:
 	UPROPERTY(EditAnywhere, Category="UI")
 	FLinearColor SelectionBoxColor;
 
+	/** Units whose projected location is within this many pixels of the selection box are also selected */
+	UPROPERTY(EditAnywhere, Category="UI", meta = (ClampMin = 0, ClampMax = 100, Units="px"))
+	float SelectionBoxPadding = 16.0f;
+
+	/** Units inside the selection box, reused between frames */
+	TArray<AStrategyUnit*> BoxedUnits;
+
+	/** Color of the selected unit markers */
+	UPROPERTY(EditAnywhere, Category="UI")
+	FLinearColor SelectionMarkerColor = FLinearColor::White;
+
+	/** Half-size of the selected unit markers */
+	UPROPERTY(EditAnywhere, Category="UI", meta = (ClampMin = 1, ClampMax = 100, Units="px"))
+	float SelectionMarkerSize = 8.0f;
+
+	/** Vertical screen offset from a selected unit's location to its marker */
+	UPROPERTY(EditAnywhere, Category="UI", meta = (ClampMin = -200, ClampMax = 200, Units="px"))
+	float SelectionMarkerOffset = 25.0f;
+
+	/** Triangles for all the selected unit markers, reused between frames */
+	TArray<FCanvasUVTri> SelectionMarkerTriangles;
+
 public:
 
 	/** Initialization */
@@ -55,4 +79,10 @@ protected:
 
 	/** Draws the HUD */
 	virtual void DrawHUD() override;
+
+	/** Draws a marker under each selected unit in a single batched canvas draw */
+	void DrawSelectionMarkers(const TArray<AStrategyUnit*>& SelectedUnits);
+
+	/** Projects every registered unit once and collects the ones inside the selection box */
+	void GetUnitsInSelectionBox(TArray<AStrategyUnit*>& OutUnits) const;
 };